@@ -54,12 +54,261 @@
 **************************************************************************/
 #include "bmp280.h"
 static struct bmp280_t *p_bmp280; /**< pointer to BMP280 */
+/* standby time t_sb in us, indexed by the config register value */
+static const u32 a_bmp280_standby_usec_u32[BMP280_EIGHT_U8X] = {
+500, 62500, 125000, 250000, 500000, 1000000, 2000000, 4000000};
+/*!
+ *	@brief Computes the maximum measurement time in us
+ *	for the given oversampling settings
+ *
+ *  @param v_osrs_t_u8 : The temperature oversampling
+ *  @param v_osrs_p_u8 : The pressure oversampling
+ *
+ *  @return the measurement time in us
+ *
+*/
+static u32 bmp280_meas_time_usec(u8 v_osrs_t_u8, u8 v_osrs_p_u8)
+{
+	u32 v_units_u32 = BMP280_ZERO_U8X;
+
+	if (v_osrs_t_u8 > BMP280_OVERSAMP_16X)
+		v_osrs_t_u8 = BMP280_OVERSAMP_16X;
+	if (v_osrs_p_u8 > BMP280_OVERSAMP_16X)
+		v_osrs_p_u8 = BMP280_OVERSAMP_16X;
+	v_units_u32 = T_INIT_MAX + T_MEASURE_PER_OSRS_MAX *
+	((((u32)BMP280_ONE_U8X << v_osrs_t_u8) >> SHIFT_RIGHT_1_POSITION) +
+	(((u32)BMP280_ONE_U8X << v_osrs_p_u8) >> SHIFT_RIGHT_1_POSITION)) +
+	(v_osrs_p_u8 ? T_SETUP_PRESSURE_MAX : BMP280_ZERO_U8X);
+	return (v_units_u32 * T_UNIT_USEC_NUMERATOR +
+	T_UNIT_USEC_DENOMINATOR - BMP280_ONE_U8X) / T_UNIT_USEC_DENOMINATOR;
+}
+/*!
+ *	@brief This API combines the results of several calls, e.g.
+ *	of functions that go over many devices: the first error is
+ *	kept, so errors cannot add up to another code or wrap around
+ *	to SUCCESS
+ *
+ *
+ *
+ *  @param v_rslt_s8 : The result so far
+ *  @param v_next_s8 : The result of the next call
+ *
+ *
+ *  @return the combined result
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_first_error(
+BMP280_RETURN_FUNCTION_TYPE v_rslt_s8, BMP280_RETURN_FUNCTION_TYPE v_next_s8)
+{
+	return (v_rslt_s8 != SUCCESS) ? v_rslt_s8 : v_next_s8;
+}
+/* Running mean in 32 bit arithmetic: the mean stays the floor of
+ * sum / count and *v_rem_s32 keeps sum - mean * count, so it is exact
+ * without a 64 bit sum. v_count_u32 includes the new value. */
+static s32 bmp280_mean_update(s32 v_mean_s32, s32 *v_rem_s32,
+s32 v_value_s32, u32 v_count_u32)
+{
+	s32 v_diff_s32 = v_value_s32 - v_mean_s32 + *v_rem_s32;
+	s32 v_step_s32 = v_diff_s32 / (s32)v_count_u32;
+
+	*v_rem_s32 = v_diff_s32 - v_step_s32 * (s32)v_count_u32;
+	if (*v_rem_s32 < BMP280_ZERO_U8X) {
+		v_step_s32--;
+		*v_rem_s32 += (s32)v_count_u32;
+	}
+	return v_mean_s32 + v_step_s32;
+}
+/* (v_a_u32 * v_b_u32 + v_add_u32) / v_c_u32 rounded down, saturated to
+ * 32 bit. Without 64 bit support the product is formed from 16 bit
+ * halves and divided bit by bit, with the same result. */
+static u32 bmp280_mul_div_u32(u32 v_a_u32, u32 v_b_u32, u32 v_add_u32,
+u32 v_c_u32)
+{
+#if defined(BMP280_ENABLE_INT64) && defined(BMP280_64BITSUPPORT_PRESENT)
+	u64 v_num_u64 = (u64)v_a_u32 * v_b_u32 + v_add_u32;
+
+	if ((v_num_u64 >> SHIFT_RIGHT_32_POSITION) >= v_c_u32)
+		return (u32)~BMP280_ZERO_U8X;
+	#if defined __KERNEL__
+		return (u32)div_u64(v_num_u64, v_c_u32);
+	#else
+		return (u32)(v_num_u64 / v_c_u32);
+	#endif
+#else
+	u32 v_low_u32 = (u32)(u16)v_a_u32 * (u16)v_b_u32;
+	u32 v_mid_a_u32 = (v_a_u32 >> SHIFT_RIGHT_16_POSITION) * (u16)v_b_u32;
+	u32 v_mid_b_u32 = (u32)(u16)v_a_u32 *
+	(v_b_u32 >> SHIFT_RIGHT_16_POSITION);
+	u32 v_high_u32 = (v_a_u32 >> SHIFT_RIGHT_16_POSITION) *
+	(v_b_u32 >> SHIFT_RIGHT_16_POSITION);
+	u32 v_carry_u32 = (v_low_u32 >> SHIFT_RIGHT_16_POSITION) +
+	(u16)v_mid_a_u32 + (u16)v_mid_b_u32;
+	u8 v_bit_u8 = BMP280_ZERO_U8X;
+	u8 v_top_u8 = BMP280_ZERO_U8X;
+
+	v_low_u32 = (u16)v_low_u32 | (v_carry_u32 << SHIFT_LEFT_16_POSITION);
+	v_high_u32 += (v_mid_a_u32 >> SHIFT_RIGHT_16_POSITION) +
+	(v_mid_b_u32 >> SHIFT_RIGHT_16_POSITION) +
+	(v_carry_u32 >> SHIFT_RIGHT_16_POSITION);
+	v_low_u32 += v_add_u32;
+	if (v_low_u32 < v_add_u32)
+		v_high_u32++;
+	if (v_high_u32 >= v_c_u32)
+		return (u32)~BMP280_ZERO_U8X;
+	/* restoring division, the quotient replaces the low word */
+	for (v_bit_u8 = BMP280_ZERO_U8X; v_bit_u8 < SHIFT_LEFT_32_POSITION;
+	v_bit_u8++) {
+		v_top_u8 = (u8)(v_high_u32 >> SHIFT_RIGHT_31_POSITION);
+		v_high_u32 = (v_high_u32 << SHIFT_LEFT_1_POSITION) |
+		(v_low_u32 >> SHIFT_RIGHT_31_POSITION);
+		v_low_u32 <<= SHIFT_LEFT_1_POSITION;
+		if (v_top_u8 || v_high_u32 >= v_c_u32) {
+			v_high_u32 -= v_c_u32;
+			v_low_u32 |= BMP280_ONE_U8X;
+		}
+	}
+	return v_low_u32;
+#endif
+}
+/*!
+ *	@brief Starts a forced mode measurement on the given device
+ *	without touching the selected device pointer
+ *
+ *  @param p_dev : The device
+ *
+ *  @return results of bus communication function
+ *
+*/
+static BMP280_RETURN_FUNCTION_TYPE bmp280_dev_trigger_forced(
+struct bmp280_t *p_dev)
+{
+	u8 v_data_u8 = BMP280_ZERO_U8X;
+
+	if (p_dev == BMP280_NULL)
+		return  E_BMP280_NULL_PTR;
+	v_data_u8 = (p_dev->oversamp_temperature
+	<< SHIFT_LEFT_5_POSITION) +
+	(p_dev->oversamp_pressure << SHIFT_LEFT_2_POSITION) +
+	BMP280_FORCED_MODE;
+	return p_dev->BMP280_BUS_WRITE_FUNC(
+	p_dev->dev_addr, BMP280_CTRL_MEAS_REG,
+	&v_data_u8, BMP280_ONE_U8X);
+}
+/*!
+ *	@brief Waits for the end of a forced conversion of the given
+ *	device. With a delay_usec function the wait is exact to the
+ *	microsecond and the measuring bit is polled afterwards, else
+ *	it is rounded up to delay_msec granularity.
+ *
+ *  @param p_dev : The device
+ *  @param v_wait_usec_u32 : The conversion time in us
+ *
+ *  @return results of bus communication function
+ *
+*/
+static BMP280_RETURN_FUNCTION_TYPE bmp280_dev_wait_conversion(
+struct bmp280_t *p_dev, u32 v_wait_usec_u32)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = SUCCESS;
+	u8 v_status_u8 = BMP280_STATUS_REG_MEASURING__MSK;
+	u8 v_poll_u8 = BMP280_ZERO_U8X;
+
+	if (p_dev->delay_usec == BMP280_NULL) {
+		p_dev->delay_msec((BMP280_MDELAY_DATA_TYPE)
+		((v_wait_usec_u32 + BMP280_USEC_PER_MSEC - BMP280_ONE_U8X)
+		/ BMP280_USEC_PER_MSEC));
+		return com_rslt;
+	}
+	if (v_wait_usec_u32 > BMP280_ZERO_U8X)
+		p_dev->delay_usec(v_wait_usec_u32);
+	while (com_rslt == SUCCESS && v_poll_u8++ < BMP280_WAIT_POLL_MAX) {
+		com_rslt = p_dev->BMP280_BUS_READ_FUNC(p_dev->dev_addr,
+		BMP280_STAT_REG, &v_status_u8, BMP280_ONE_U8X);
+		if (!(v_status_u8 & BMP280_STATUS_REG_MEASURING__MSK))
+			break;
+		p_dev->delay_usec(BMP280_WAIT_POLL_USEC);
+	}
+	return com_rslt;
+}
+/*!
+ *	@brief Decodes a 20 bit pressure or temperature value
+ *	from its MSB, LSB and XLSB register bytes
+ *
+ *  @param a_data_u8 : The three data bytes
+ *
+ *  @return the uncompensated value
+ *
+*/
+static s32 bmp280_decode_uncomp(const u8 *a_data_u8)
+{
+	return (s32)((((u32)(a_data_u8[INDEX_ZERO]))
+	<< SHIFT_LEFT_12_POSITION) |
+	(((u32)(a_data_u8[INDEX_ONE]))
+	<< SHIFT_LEFT_4_POSITION) |
+	((u32)a_data_u8[INDEX_TWO] >>
+	SHIFT_RIGHT_4_POSITION));
+}
+/*!
+ *	@brief Returns how many data bytes of a channel carry information.
+ *	With oversampling x1 and the IIR filter off the result has 16 bit,
+ *	so the XLSB register is always zero and need not be read.
+ *	The filter comes from the cache, which bmp280_init(), the config
+ *	register writers and bmp280_set_soft_rst() keep in step.
+ *
+ *  @param p_dev : The device
+ *  @param v_osrs_u8 : The oversampling of the channel
+ *
+ *  @return BMP280_TWO_U8X or BMP280_THREE_U8X
+ *
+*/
+static u8 bmp280_dev_data_len(const struct bmp280_t *p_dev, u8 v_osrs_u8)
+{
+	return (v_osrs_u8 == BMP280_OVERSAMP_1X &&
+	p_dev->filter == BMP280_FILTER_COEFF_OFF) ?
+	BMP280_TWO_U8X : BMP280_THREE_U8X;
+}
+/*!
+ *	@brief Burst reads uncompensated pressure and temperature
+ *	of the given device without touching the selected device pointer
+ *
+ *  @param p_dev : The device
+ *  @param v_uncomp_pressure_s32 : The uncompensated pressure
+ *  @param v_uncomp_temperature_s32 : The uncompensated temperature
+ *
+ *  @return results of bus communication function
+ *
+*/
+static BMP280_RETURN_FUNCTION_TYPE bmp280_dev_read_uncomp(
+struct bmp280_t *p_dev, s32 *v_uncomp_pressure_s32,
+s32 *v_uncomp_temperature_s32)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	u8 a_data_u8[ARRAY_SIZE_SIX] = {BMP280_ZERO_U8X, BMP280_ZERO_U8X,
+	BMP280_ZERO_U8X, BMP280_ZERO_U8X,
+	BMP280_ZERO_U8X, BMP280_ZERO_U8X};
+
+	if (p_dev == BMP280_NULL)
+		return  E_BMP280_NULL_PTR;
+	/* the temperature XLSB is the last byte of the burst */
+	com_rslt = p_dev->BMP280_BUS_READ_FUNC(p_dev->dev_addr,
+	BMP280_PRESSURE_MSB_REG, a_data_u8, BMP280_THREE_U8X +
+	bmp280_dev_data_len(p_dev, p_dev->oversamp_temperature));
+	*v_uncomp_pressure_s32 = bmp280_decode_uncomp(
+	&a_data_u8[INDEX_ZERO]);
+	*v_uncomp_temperature_s32 = bmp280_decode_uncomp(
+	&a_data_u8[INDEX_THREE]);
+	return com_rslt;
+}
 
 /*!
  *	@brief This function is used for initialize
  *	the bus read and bus write functions
  *  and assign the chip id and I2C address of the BMP280 sensor
  *	chip id is read in the register 0xD0 bit from 0 to 7
+ *	the oversampling and the filter are read back into the cache
  *
  *	@param *bmp280 structure pointer.
  *
@@ -71,6 +320,10 @@ static struct bmp280_t *p_bmp280; /**< pointer to BMP280 */
  *	affect the reference value of the parameter
  *	(Better case don't change the reference value of the parameter)
  *
+ *	@note delay_usec is optional and is only called when it is not
+ *	BMP280_NULL. Zero the structure before filling it in, so that
+ *	callers which do not set delay_usec fall back to delay_msec.
+ *
  *
  *
  *
@@ -92,6 +345,11 @@ BMP280_RETURN_FUNCTION_TYPE bmp280_init(struct bmp280_t *bmp280)
 	p_bmp280->chip_id = v_data_u8;
 	/* readout bmp280 calibparam structure */
 	com_rslt += bmp280_get_calib_param();
+	/* cache the filter and the oversampling of ctrl_meas,
+	they select the data read lengths */
+	com_rslt += bmp280_get_filter(&v_data_u8);
+	com_rslt += bmp280_get_oversamp_temperature(&v_data_u8);
+	com_rslt += bmp280_get_oversamp_pressure(&v_data_u8);
 	return com_rslt;
 }
 /*!
@@ -100,6 +358,8 @@ BMP280_RETURN_FUNCTION_TYPE bmp280_init(struct bmp280_t *bmp280)
  *	@note 0xFA -> MSB -> bit from 0 to 7
  *	@note 0xFB -> LSB -> bit from 0 to 7
  *	@note 0xFC -> LSB -> bit from 4 to 7
+ *	@note 0xFC is not read when the oversampling is x1 and
+ *	the filter is off, its bits are zero then
  *
  *	@param v_uncomp_temperature_s32 : The uncompensated temperature.
  *
@@ -131,7 +391,8 @@ s32 *v_uncomp_temperature_s32)
 			com_rslt = p_bmp280->BMP280_BUS_READ_FUNC(
 			p_bmp280->dev_addr,
 			BMP280_TEMPERATURE_MSB_REG,
-			a_data_u8r, BMP280_THREE_U8X);
+			a_data_u8r, bmp280_dev_data_len(p_bmp280,
+			p_bmp280->oversamp_temperature));
 			*v_uncomp_temperature_s32 = (s32)(((
 			(u32) (a_data_u8r[INDEX_ZERO]))
 			<< SHIFT_LEFT_12_POSITION) |
@@ -143,21 +404,17 @@ s32 *v_uncomp_temperature_s32)
 	return com_rslt;
 }
 /*!
- *	@brief Reads actual temperature
- *	from uncompensated temperature
- *	@note Returns the value in 0.01 degree Centigrade
- *	@note Output value of "5123" equals 51.23 DegC.
- *
- *
+ *	@brief Computes the temperature in 0.01 DegC and t_fine
+ *	from the given calibration parameters
  *
+ *  @param calib : The calibration parameters, t_fine is updated
  *  @param v_uncomp_temperature_s32 : value of uncompensated temperature
  *
- *
- *
  *  @return Actual temperature output as s32
  *
 */
-s32 bmp280_compensate_T_int32(s32 v_uncomp_temperature_s32)
+static s32 bmp280_calib_compensate_T_int32(
+struct bmp280_calib_param_t *calib, s32 v_uncomp_temperature_s32)
 {
 	s32 v_x1_u32r = BMP280_ZERO_U8X;
 	s32 v_x2_u32r = BMP280_ZERO_U8X;
@@ -165,31 +422,53 @@ s32 bmp280_compensate_T_int32(s32 v_uncomp_temperature_s32)
 	/* calculate true temperature*/
 	v_x1_u32r  = ((((v_uncomp_temperature_s32
 	>> SHIFT_RIGHT_3_POSITION) - ((s32)
-	p_bmp280->calib_param.dig_T1 << SHIFT_LEFT_1_POSITION))) *
-	((s32)p_bmp280->calib_param.dig_T2))
+	calib->dig_T1 << SHIFT_LEFT_1_POSITION))) *
+	((s32)calib->dig_T2))
 	>> SHIFT_RIGHT_11_POSITION;
 	v_x2_u32r  = (((((v_uncomp_temperature_s32
 	>> SHIFT_RIGHT_4_POSITION) -
-	((s32)p_bmp280->calib_param.dig_T1)) *
+	((s32)calib->dig_T1)) *
 	((v_uncomp_temperature_s32 >> SHIFT_RIGHT_4_POSITION) -
-	((s32)p_bmp280->calib_param.dig_T1)))
+	((s32)calib->dig_T1)))
 	>> SHIFT_RIGHT_12_POSITION) *
-	((s32)p_bmp280->calib_param.dig_T3))
+	((s32)calib->dig_T3))
 	>> SHIFT_RIGHT_14_POSITION;
-	p_bmp280->calib_param.t_fine = v_x1_u32r + v_x2_u32r;
-	temperature  = (p_bmp280->calib_param.t_fine *
+	calib->t_fine = v_x1_u32r + v_x2_u32r;
+	temperature  = (calib->t_fine *
 	BMP20_DEC_TRUE_TEMP_FIVE_DATA
 	+ BMP20_DEC_TRUE_TEMP_ONE_TWO_EIGHT_DATA)
 	>> SHIFT_RIGHT_8_POSITION;
 
 	return temperature;
 }
+/*!
+ *	@brief Reads actual temperature
+ *	from uncompensated temperature
+ *	@note Returns the value in 0.01 degree Centigrade
+ *	@note Output value of "5123" equals 51.23 DegC.
+ *
+ *
+ *
+ *  @param v_uncomp_temperature_s32 : value of uncompensated temperature
+ *
+ *
+ *
+ *  @return Actual temperature output as s32
+ *
+*/
+s32 bmp280_compensate_T_int32(s32 v_uncomp_temperature_s32)
+{
+	return bmp280_calib_compensate_T_int32(&p_bmp280->calib_param,
+	v_uncomp_temperature_s32);
+}
 /*!
  *	@brief This API is used to read uncompensated pressure.
  *	in the registers 0xF7, 0xF8 and 0xF9
  *	@note 0xF7 -> MSB -> bit from 0 to 7
  *	@note 0xF8 -> LSB -> bit from 0 to 7
  *	@note 0xF9 -> LSB -> bit from 4 to 7
+ *	@note 0xF9 is not read when the oversampling is x1 and
+ *	the filter is off, its bits are zero then
  *
  *
  *
@@ -222,7 +501,8 @@ s32 *v_uncomp_pressure_s32)
 			com_rslt = p_bmp280->BMP280_BUS_READ_FUNC(
 			p_bmp280->dev_addr,
 			BMP280_PRESSURE_MSB_REG,
-			a_data_u8, BMP280_THREE_U8X);
+			a_data_u8, bmp280_dev_data_len(p_bmp280,
+			p_bmp280->oversamp_pressure));
 			*v_uncomp_pressure_s32 = (s32)(
 			(((u32)(a_data_u8[INDEX_ZERO]))
 			<< SHIFT_LEFT_12_POSITION) |
@@ -234,94 +514,180 @@ s32 *v_uncomp_pressure_s32)
 	return com_rslt;
 }
 /*!
- *	@brief Reads actual pressure from uncompensated pressure
- *	and returns the value in Pascal(Pa)
- *	@note Output value of "96386" equals 96386 Pa =
- *	963.86 hPa = 963.86 millibar
- *
+ *	@brief Computes the part of the pressure compensation that
+ *	depends on t_fine only: the divisor and the offset
  *
- *
- *
- *  @param  v_uncomp_pressure_s32: value of uncompensated pressure
- *
- *
- *
- *  @return Returns the Actual pressure out put as s32
+ *  @param calib : The calibration parameters
+ *  @param v_t_fine_s32 : The fine temperature
+ *  @param v_divisor_s32 : The pressure divisor
+ *  @param v_offset_s32 : The pressure offset
  *
 */
-u32 bmp280_compensate_P_int32(s32 v_uncomp_pressure_s32)
+static void bmp280_calib_P_coeff(const struct bmp280_calib_param_t *calib,
+s32 v_t_fine_s32, s32 *v_divisor_s32, s32 *v_offset_s32)
 {
 	s32 v_x1_u32r = BMP280_ZERO_U8X;
 	s32 v_x2_u32r = BMP280_ZERO_U8X;
-	u32 v_pressure_u32 = BMP280_ZERO_U8X;
-	/* calculate true pressure*/
-	v_x1_u32r = (((s32)p_bmp280->calib_param.t_fine)
-	>> SHIFT_RIGHT_1_POSITION) -
+
+	v_x1_u32r = (v_t_fine_s32 >> SHIFT_RIGHT_1_POSITION) -
 	(s32)BMP20_DEC_TRUE_PRESSURE_6_4_0_0_0_DATA;
 	v_x2_u32r = (((v_x1_u32r >> SHIFT_RIGHT_2_POSITION) *
 	(v_x1_u32r >> SHIFT_RIGHT_2_POSITION))
 	>> SHIFT_RIGHT_11_POSITION) *
-	((s32)p_bmp280->calib_param.dig_P6);
+	((s32)calib->dig_P6);
 	v_x2_u32r = v_x2_u32r + ((v_x1_u32r *
-	((s32)p_bmp280->calib_param.dig_P5))
+	((s32)calib->dig_P5))
 	<< SHIFT_LEFT_1_POSITION);
 	v_x2_u32r = (v_x2_u32r >> SHIFT_RIGHT_2_POSITION) +
-	(((s32)p_bmp280->calib_param.dig_P4)
+	(((s32)calib->dig_P4)
 	<< SHIFT_LEFT_16_POSITION);
-	v_x1_u32r = (((p_bmp280->calib_param.dig_P3 *
+	v_x1_u32r = (((calib->dig_P3 *
 	(((v_x1_u32r >> SHIFT_RIGHT_2_POSITION) *
 	(v_x1_u32r >> SHIFT_RIGHT_2_POSITION))
 	>> SHIFT_RIGHT_13_POSITION)) >> SHIFT_RIGHT_3_POSITION) +
-	((((s32)p_bmp280->calib_param.dig_P2) *
+	((((s32)calib->dig_P2) *
 	v_x1_u32r) >> SHIFT_RIGHT_1_POSITION))
 	>> SHIFT_RIGHT_18_POSITION;
-	v_x1_u32r = ((((BMP20_DEC_TRUE_PRESSURE_3_2_7_6_8_DATA
+	*v_divisor_s32 = ((((BMP20_DEC_TRUE_PRESSURE_3_2_7_6_8_DATA
 	+ v_x1_u32r)) *
-	((s32)p_bmp280->calib_param.dig_P1))
+	((s32)calib->dig_P1))
 	>> SHIFT_RIGHT_15_POSITION);
+	*v_offset_s32 = v_x2_u32r >> SHIFT_RIGHT_12_POSITION;
+}
+/*!
+ *	@brief Computes the pressure in Pa from the t_fine
+ *	dependent divisor and offset
+ *
+ *  @param calib : The calibration parameters
+ *  @param v_divisor_s32 : The pressure divisor
+ *  @param v_offset_s32 : The pressure offset
+ *  @param v_uncomp_pressure_s32 : value of uncompensated pressure
+ *
+ *  @return Actual pressure output as u32
+ *
+*/
+static u32 bmp280_calib_P_apply(const struct bmp280_calib_param_t *calib,
+s32 v_divisor_s32, s32 v_offset_s32, s32 v_uncomp_pressure_s32)
+{
+	s32 v_x1_u32r = BMP280_ZERO_U8X;
+	s32 v_x2_u32r = BMP280_ZERO_U8X;
+	u32 v_pressure_u32 = BMP280_ZERO_U8X;
+
+	/* Avoid exception caused by division by zero */
+	if (v_divisor_s32 == BMP280_ZERO_U8X)
+		return BMP280_ZERO_U8X;
 	v_pressure_u32 =
 	(((u32)(((s32)BMP20_DEC_TRUE_PRESSURE_1_0_4_8_5_7_6_DATA)
-	- v_uncomp_pressure_s32) -
-	(v_x2_u32r >> SHIFT_RIGHT_12_POSITION)))
+	- v_uncomp_pressure_s32) - v_offset_s32))
 	* BMP20_DEC_TRUE_PRESSURE_3_1_2_5_DATA;
 	if (v_pressure_u32
 	< BMP20_HEX_TRUE_PRESSURE_8_0_0_0_0_0_0_0_DATA)
-		/* Avoid exception caused by division by zero */
-		if (v_x1_u32r != BMP280_ZERO_U8X)
-			v_pressure_u32 =
-			(v_pressure_u32 << SHIFT_LEFT_1_POSITION)
-			/ ((u32)v_x1_u32r);
-		else
-			return BMP280_ZERO_U8X;
+		v_pressure_u32 = (v_pressure_u32 << SHIFT_LEFT_1_POSITION)
+		/ ((u32)v_divisor_s32);
 	else
-		/* Avoid exception caused by division by zero */
-		if (v_x1_u32r != BMP280_ZERO_U8X)
-			v_pressure_u32 = (v_pressure_u32 /
-			(u32)v_x1_u32r)
-			* BMP20_DEC_TRUE_PRESSURE_TWO_DATA;
-		else
-			return BMP280_ZERO_U8X;
-		v_x1_u32r = (((s32)
-		p_bmp280->calib_param.dig_P9) *
-		((s32)(((v_pressure_u32
-		>> SHIFT_RIGHT_3_POSITION)
-		* (v_pressure_u32 >> SHIFT_RIGHT_3_POSITION))
-		>> SHIFT_RIGHT_13_POSITION)))
-		>> SHIFT_RIGHT_12_POSITION;
-		v_x2_u32r = (((s32)(v_pressure_u32
-		>> SHIFT_RIGHT_2_POSITION)) *
-		((s32)p_bmp280->calib_param.dig_P8))
-		>> SHIFT_RIGHT_13_POSITION;
-		v_pressure_u32 = (u32)
-		((s32)v_pressure_u32 +
-		((v_x1_u32r + v_x2_u32r +
-		p_bmp280->calib_param.dig_P7)
-		>> SHIFT_RIGHT_4_POSITION));
+		v_pressure_u32 = (v_pressure_u32 / (u32)v_divisor_s32)
+		* BMP20_DEC_TRUE_PRESSURE_TWO_DATA;
+	v_x1_u32r = (((s32)
+	calib->dig_P9) *
+	((s32)(((v_pressure_u32
+	>> SHIFT_RIGHT_3_POSITION)
+	* (v_pressure_u32 >> SHIFT_RIGHT_3_POSITION))
+	>> SHIFT_RIGHT_13_POSITION)))
+	>> SHIFT_RIGHT_12_POSITION;
+	v_x2_u32r = (((s32)(v_pressure_u32
+	>> SHIFT_RIGHT_2_POSITION)) *
+	((s32)calib->dig_P8))
+	>> SHIFT_RIGHT_13_POSITION;
+	v_pressure_u32 = (u32)
+	((s32)v_pressure_u32 +
+	((v_x1_u32r + v_x2_u32r +
+	calib->dig_P7)
+	>> SHIFT_RIGHT_4_POSITION));
 
 	return v_pressure_u32;
 }
+/*!
+ *	@brief Computes the pressure in Pa from the given
+ *	calibration parameters and their t_fine
+ *
+ *  @param calib : The calibration parameters
+ *  @param v_uncomp_pressure_s32 : value of uncompensated pressure
+ *
+ *  @return Actual pressure output as u32
+ *
+*/
+static u32 bmp280_calib_compensate_P_int32(
+const struct bmp280_calib_param_t *calib, s32 v_uncomp_pressure_s32)
+{
+	s32 v_divisor_s32 = BMP280_ZERO_U8X;
+	s32 v_offset_s32 = BMP280_ZERO_U8X;
+
+	bmp280_calib_P_coeff(calib, calib->t_fine, &v_divisor_s32,
+	&v_offset_s32);
+	return bmp280_calib_P_apply(calib, v_divisor_s32, v_offset_s32,
+	v_uncomp_pressure_s32);
+}
+/*!
+ *	@brief Compensates temperature and pressure, reusing the
+ *	temperature, t_fine and pressure coefficients of the previous
+ *	call when the raw temperature did not change
+ *
+ *  @param calib : The calibration parameters, t_fine is updated
+ *  @param memo : The cached result of the last raw temperature
+ *  @param v_uncomp_temperature_s32 : value of uncompensated temperature
+ *  @param v_uncomp_pressure_s32 : value of uncompensated pressure
+ *  @param v_temperature_s32 : Actual temperature in 0.01 DegC
+ *  @param v_pressure_u32 : Actual pressure in Pa
+ *
+*/
+static void bmp280_calib_compensate_memo(
+struct bmp280_calib_param_t *calib, struct bmp280_comp_memo_t *memo,
+s32 v_uncomp_temperature_s32, s32 v_uncomp_pressure_s32,
+s32 *v_temperature_s32, u32 *v_pressure_u32)
+{
+	if (memo->valid &&
+	memo->uncomp_temperature == v_uncomp_temperature_s32) {
+		memo->hit_count++;
+		calib->t_fine = memo->t_fine;
+	} else {
+		memo->miss_count++;
+		memo->temperature = bmp280_calib_compensate_T_int32(calib,
+		v_uncomp_temperature_s32);
+		memo->uncomp_temperature = v_uncomp_temperature_s32;
+		memo->t_fine = calib->t_fine;
+		bmp280_calib_P_coeff(calib, calib->t_fine, &memo->p_divisor,
+		&memo->p_offset);
+		memo->valid = BMP280_ONE_U8X;
+	}
+	*v_temperature_s32 = memo->temperature;
+	*v_pressure_u32 = bmp280_calib_P_apply(calib, memo->p_divisor,
+	memo->p_offset, v_uncomp_pressure_s32);
+}
+/*!
+ *	@brief Reads actual pressure from uncompensated pressure
+ *	and returns the value in Pascal(Pa)
+ *	@note Output value of "96386" equals 96386 Pa =
+ *	963.86 hPa = 963.86 millibar
+ *
+ *
+ *
+ *
+ *  @param  v_uncomp_pressure_s32: value of uncompensated pressure
+ *
+ *
+ *
+ *  @return Returns the Actual pressure out put as s32
+ *
+*/
+u32 bmp280_compensate_P_int32(s32 v_uncomp_pressure_s32)
+{
+	return bmp280_calib_compensate_P_int32(&p_bmp280->calib_param,
+	v_uncomp_pressure_s32);
+}
 /*!
  * @brief reads uncompensated pressure and temperature
+ * @note The temperature XLSB 0xFC is not read when the temperature
+ * oversampling is x1 and the filter is off, its bits are zero then
  *
  *
  * @param  v_uncomp_pressure_s32: The value of uncompensated pressure.
@@ -353,9 +719,12 @@ s32 *v_uncomp_temperature_s32)
 	if (p_bmp280 == BMP280_NULL) {
 		return  E_BMP280_NULL_PTR;
 		} else {
+			/* the temperature XLSB is the last byte of the burst */
 			com_rslt = p_bmp280->BMP280_BUS_READ_FUNC(
 			p_bmp280->dev_addr,
-			BMP280_PRESSURE_MSB_REG, a_data_u8, BMP280_SIX_U8X);
+			BMP280_PRESSURE_MSB_REG, a_data_u8,
+			BMP280_THREE_U8X + bmp280_dev_data_len(p_bmp280,
+			p_bmp280->oversamp_temperature));
 			/*Pressure*/
 			*v_uncomp_pressure_s32 = (s32)(
 			(((u32)(a_data_u8[INDEX_ZERO]))
@@ -378,6 +747,8 @@ s32 *v_uncomp_temperature_s32)
 }
 /*!
  * @brief This API reads the true pressure and temperature
+ * @note The temperature, t_fine and pressure coefficients are
+ * reused from the previous call while the raw temperature is unchanged
  *
  *
  *  @param  v_pressure_u32 : The value of compensated pressure.
@@ -405,11 +776,12 @@ s32 *v_temperature_s32)
 			/* read uncompensated pressure and temperature*/
 			com_rslt = bmp280_read_uncomp_pressure_temperature(
 			&v_uncomp_pressure_s32, &v_uncomp_temperature_s32);
-			/* read trure pressure and temperature*/
-			*v_temperature_s32 = bmp280_compensate_T_int32(
-			v_uncomp_temperature_s32);
-			*v_pressure_u32 = bmp280_compensate_P_int32(
-			v_uncomp_pressure_s32);
+			/* read true pressure and temperature, the
+			temperature part is reused while it is unchanged*/
+			bmp280_calib_compensate_memo(&p_bmp280->calib_param,
+			&p_bmp280->memo, v_uncomp_temperature_s32,
+			v_uncomp_pressure_s32, v_temperature_s32,
+			v_pressure_u32);
 		}
 	return com_rslt;
 }
@@ -497,6 +869,8 @@ BMP280_RETURN_FUNCTION_TYPE bmp280_get_calib_param()
 			p_bmp280->calib_param.dig_P9 = (s16)(((
 			(s16)((s8)a_data_u8[INDEX_TWENTY_THREE])) <<
 			SHIFT_LEFT_8_POSITION) | a_data_u8[INDEX_TWENTY_TWO]);
+			/* results of the old calibration are stale */
+			p_bmp280->memo.valid = BMP280_ZERO_U8X;
 		}
 	return com_rslt;
 }
@@ -816,6 +1190,9 @@ BMP280_RETURN_FUNCTION_TYPE bmp280_set_soft_rst()
 			com_rslt = p_bmp280->BMP280_BUS_WRITE_FUNC(
 			p_bmp280->dev_addr,
 			BMP280_RST_REG, &v_data_u8, BMP280_ONE_U8X);
+			/* the reset clears the config register */
+			if (com_rslt == SUCCESS)
+				p_bmp280->filter = BMP280_FILTER_COEFF_OFF;
 		}
 	return com_rslt;
 }
@@ -892,6 +1269,9 @@ BMP280_RETURN_FUNCTION_TYPE bmp280_set_spi3(u8 v_enable_disable_u8)
 			BMP280_CONFIG_REG_SPI3_ENABLE__REG,
 			&v_data_u8, BMP280_ONE_U8X);
 			if (com_rslt == SUCCESS) {
+				/* keep the cached filter in step */
+				p_bmp280->filter = BMP280_GET_BITSLICE(
+				v_data_u8, BMP280_CONFIG_REG_FILTER);
 				v_data_u8 = BMP280_SET_BITSLICE(
 				v_data_u8,
 				BMP280_CONFIG_REG_SPI3_ENABLE,
@@ -942,6 +1322,7 @@ BMP280_RETURN_FUNCTION_TYPE bmp280_get_filter(u8 *v_value_u8)
 			&v_data_u8, BMP280_ONE_U8X);
 			*v_value_u8 = BMP280_GET_BITSLICE(v_data_u8,
 			BMP280_CONFIG_REG_FILTER);
+			p_bmp280->filter = *v_value_u8;
 		}
 	return com_rslt;
 }
@@ -988,6 +1369,8 @@ BMP280_RETURN_FUNCTION_TYPE bmp280_set_filter(u8 v_value_u8)
 				p_bmp280->dev_addr,
 				BMP280_CONFIG_REG_FILTER__REG,
 				&v_data_u8, BMP280_ONE_U8X);
+				if (com_rslt == SUCCESS)
+					p_bmp280->filter = v_value_u8;
 			}
 		}
 	return com_rslt;
@@ -1085,6 +1468,9 @@ BMP280_RETURN_FUNCTION_TYPE bmp280_set_standby_durn(u8 v_standby_durn_u8)
 			BMP280_CONFIG_REG_STANDBY_DURN__REG,
 			&v_data_u8, BMP280_ONE_U8X);
 			if (com_rslt == SUCCESS) {
+				/* keep the cached filter in step */
+				p_bmp280->filter = BMP280_GET_BITSLICE(
+				v_data_u8, BMP280_CONFIG_REG_FILTER);
 				v_data_u8 =
 				BMP280_SET_BITSLICE(v_data_u8,
 				BMP280_CONFIG_REG_STANDBY_DURN,
@@ -1184,6 +1570,8 @@ return com_rslt;
 /*!
  *	@brief This API used to read both
  *	uncompensated pressure and temperature in forced mode
+ *	@note The conversion wait uses delay_usec when it is set,
+ *	else delay_msec rounded up to whole milliseconds.
  *
  *
  *  @param  v_uncomp_pressure_s32: The value of uncompensated pressure.
@@ -1202,115 +1590,374 @@ s32 *v_uncomp_temperature_s32)
 {
 	/* variable used to return communication result*/
 	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
-	u8 v_data_u8 = BMP280_ZERO_U8X;
-	u8 v_waittime_u8 = BMP280_ZERO_U8X;
 	/* check the p_bmp280 struct pointer as NULL*/
 	if (p_bmp280 == BMP280_NULL) {
 		return  E_BMP280_NULL_PTR;
 		} else {
 			/* read pressure and temperature*/
-			v_data_u8 = (p_bmp280->oversamp_temperature
-			<< SHIFT_LEFT_5_POSITION) +
-			(p_bmp280->oversamp_pressure << SHIFT_LEFT_2_POSITION) +
-			BMP280_FORCED_MODE;
-			com_rslt = p_bmp280->BMP280_BUS_WRITE_FUNC(
-			p_bmp280->dev_addr,	BMP280_CTRL_MEAS_REG,
-			&v_data_u8, BMP280_ONE_U8X);
-			bmp280_compute_wait_time(&v_waittime_u8);
-			p_bmp280->delay_msec(v_waittime_u8);
+			com_rslt = bmp280_trigger_forced_measurement();
+			com_rslt += bmp280_dev_wait_conversion(p_bmp280,
+			bmp280_meas_time_usec(p_bmp280->oversamp_temperature,
+			p_bmp280->oversamp_pressure));
 			com_rslt += bmp280_read_uncomp_pressure_temperature(
 			v_uncomp_pressure_s32, v_uncomp_temperature_s32);
 		}
 	return com_rslt;
 }
 /*!
- * @brief
- *	This API write the data to
- *	the given register
- *
+ *	@brief This API starts one forced mode measurement
+ *	with the cached oversampling settings by writing
+ *	the ctrl_meas register 0xF4
+ *	@note The result is valid after bmp280_compute_wait_time()
  *
- *	@param v_addr_u8 -> Address of the register
- *	@param v_data_u8 -> The data from the register
- *	@param v_len_u8 -> no of bytes to read
  *
  *
- *	@return results of bus communication function
+ *  @return results of bus communication function
  *	@retval 0 -> Success
  *	@retval -1 -> Error
  *
  *
- */
-BMP280_RETURN_FUNCTION_TYPE bmp280_write_register(u8 v_addr_u8,
-u8 *v_data_u8, u8 v_len_u8)
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_trigger_forced_measurement(void)
 {
-	/* variable used to return communication result*/
-	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
-	/* check the p_bmp280 struct pointer as NULL*/
-	if (p_bmp280 == BMP280_NULL) {
-		return  E_BMP280_NULL_PTR;
-		} else {
-			com_rslt = p_bmp280->BMP280_BUS_WRITE_FUNC(
-			p_bmp280->dev_addr,
-			v_addr_u8, v_data_u8, v_len_u8);
-		}
-	return com_rslt;
+	return bmp280_dev_trigger_forced(p_bmp280);
 }
 /*!
- * @brief
- *	This API reads the data from
- *	the given register
+ *	@brief This API starts a forced mode measurement on every
+ *	device of a group, back to back without waiting in between
+ *	@note Group functions address the devices directly and leave
+ *	the device selected by bmp280_init() unchanged
  *
  *
- *	@param v_addr_u8 -> Address of the register
- *	@param v_data_u8 -> The data from the register
- *	@param v_len_u8 -> no of bytes to read
  *
+ *  @param a_dev : Array of initialized devices
+ *  @param v_count_u8 : Number of devices in the array
+ *  @param v_wait_usec_u32 : The longest measurement time of the group
  *
- *	@return results of bus communication function
+ *
+ *  @return results of bus communication function
  *	@retval 0 -> Success
  *	@retval -1 -> Error
  *
  *
- */
-BMP280_RETURN_FUNCTION_TYPE bmp280_read_register(u8 v_addr_u8,
-u8 *v_data_u8, u8 v_len_u8)
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_group_trigger_forced(
+struct bmp280_t *a_dev[], u8 v_count_u8, u32 *v_wait_usec_u32)
 {
-	/* variable used to return communication result*/
-	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
-	/* check the p_bmp280 struct pointer as NULL*/
-	if (p_bmp280 == BMP280_NULL) {
-		return  E_BMP280_NULL_PTR;
-		} else {
-			com_rslt = p_bmp280->BMP280_BUS_READ_FUNC(
-			p_bmp280->dev_addr,
-			v_addr_u8, v_data_u8, v_len_u8);
-		}
-	return com_rslt;
+	return bmp280_group_sync_trigger_forced(a_dev, v_count_u8,
+	BMP280_NULL, BMP280_NULL, v_wait_usec_u32);
 }
-#ifdef BMP280_ENABLE_FLOAT
 /*!
- * @brief This API used to read
- * actual temperature from uncompensated temperature
- * @note Returns the value in Degree centigrade
- * @note Output value of "51.23" equals 51.23 DegC.
+ *	@brief This API reads uncompensated pressure and temperature
+ *	from every device of a group, one burst read per device
  *
  *
  *
- *  @param v_uncomp_temperature_s32 : value of uncompensated temperature
+ *  @param a_dev : Array of initialized devices
+ *  @param v_count_u8 : Number of devices in the array
+ *  @param a_uncomp_pressure_s32 : Uncompensated pressure per device
+ *  @param a_uncomp_temperature_s32 : Uncompensated temperature per device
  *
  *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
  *
- *  @return
- *	Actual temperature in floating point
  *
 */
-double bmp280_compensate_T_double(s32 v_uncomp_temperature_s32)
+BMP280_RETURN_FUNCTION_TYPE bmp280_group_read_uncomp_pressure_temperature(
+struct bmp280_t *a_dev[], u8 v_count_u8,
+s32 a_uncomp_pressure_s32[], s32 a_uncomp_temperature_s32[])
 {
-	double v_x1_u32r = BMP280_ZERO_U8X;
-	double v_x2_u32r = BMP280_ZERO_U8X;
-	double temperature = BMP280_ZERO_U8X;
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = SUCCESS;
+	u8 v_index_u8 = BMP280_ZERO_U8X;
 
-	v_x1_u32r  = (((double)v_uncomp_temperature_s32)
+	if (a_dev == BMP280_NULL || a_uncomp_pressure_s32 == BMP280_NULL ||
+	a_uncomp_temperature_s32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	for (v_index_u8 = BMP280_ZERO_U8X; v_index_u8 < v_count_u8;
+	v_index_u8++)
+		com_rslt = bmp280_first_error(com_rslt,
+		bmp280_dev_read_uncomp(a_dev[v_index_u8],
+		&a_uncomp_pressure_s32[v_index_u8],
+		&a_uncomp_temperature_s32[v_index_u8]));
+	return com_rslt;
+}
+/*!
+ *	@brief This API reads uncompensated pressure and temperature
+ *	of a group of devices in forced mode
+ *	@note All devices are triggered first, the group waits once
+ *	for the longest conversion using the delay function of the
+ *	first device, and then every device is read. Devices with a
+ *	delay_usec function are status polled before the read.
+ *	The conversions overlap, so the group period is the longest
+ *	conversion time plus the bus time instead of their sum.
+ *
+ *
+ *
+ *  @param a_dev : Array of initialized devices
+ *  @param v_count_u8 : Number of devices in the array
+ *  @param a_uncomp_pressure_s32 : Uncompensated pressure per device
+ *  @param a_uncomp_temperature_s32 : Uncompensated temperature per device
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE
+bmp280_group_get_forced_uncomp_pressure_temperature(
+struct bmp280_t *a_dev[], u8 v_count_u8,
+s32 a_uncomp_pressure_s32[], s32 a_uncomp_temperature_s32[])
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	u32 v_wait_usec_u32 = BMP280_ZERO_U8X;
+	u8 v_index_u8 = BMP280_ZERO_U8X;
+
+	if (a_dev == BMP280_NULL || v_count_u8 == BMP280_ZERO_U8X ||
+	a_dev[INDEX_ZERO] == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	com_rslt = bmp280_group_trigger_forced(a_dev, v_count_u8,
+	&v_wait_usec_u32);
+	com_rslt = bmp280_first_error(com_rslt,
+	bmp280_dev_wait_conversion(a_dev[INDEX_ZERO], v_wait_usec_u32));
+	/* the others converted in parallel, only check their status */
+	for (v_index_u8 = BMP280_ONE_U8X; v_index_u8 < v_count_u8;
+	v_index_u8++)
+		if (a_dev[v_index_u8] != BMP280_NULL &&
+		a_dev[v_index_u8]->delay_usec != BMP280_NULL)
+			com_rslt = bmp280_first_error(com_rslt,
+			bmp280_dev_wait_conversion(a_dev[v_index_u8],
+			BMP280_ZERO_U8X));
+	com_rslt = bmp280_first_error(com_rslt,
+	bmp280_group_read_uncomp_pressure_temperature(a_dev,
+	v_count_u8, a_uncomp_pressure_s32, a_uncomp_temperature_s32));
+	return com_rslt;
+}
+/*!
+ *	@brief This API starts a forced mode measurement on every
+ *	device of a group and records when each trigger was issued
+ *	@note The timestamp of a device is taken when its ctrl_meas
+ *	write returns, which is when its conversion starts.
+ *	@note The selected device pointer is not used, so disjoint
+ *	groups, e.g. one per bus, may be triggered from parallel threads.
+ *
+ *
+ *
+ *  @param a_dev : Array of initialized devices
+ *  @param v_count_u8 : Number of devices in the array
+ *  @param get_time_usec : Monotonic time source in us, may be NULL
+ *  @param a_trigger_usec_u32 : Trigger time per device, may be NULL
+ *  @param v_wait_usec_u32 : The longest measurement time of the group
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_group_sync_trigger_forced(
+struct bmp280_t *a_dev[], u8 v_count_u8, u32 (*get_time_usec)(void),
+u32 a_trigger_usec_u32[], u32 *v_wait_usec_u32)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = SUCCESS;
+	u32 v_meas_usec_u32 = BMP280_ZERO_U8X;
+	u8 v_index_u8 = BMP280_ZERO_U8X;
+
+	if (a_dev == BMP280_NULL || v_wait_usec_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	*v_wait_usec_u32 = BMP280_ZERO_U8X;
+	for (v_index_u8 = BMP280_ZERO_U8X; v_index_u8 < v_count_u8;
+	v_index_u8++) {
+		com_rslt = bmp280_first_error(com_rslt,
+		bmp280_dev_trigger_forced(a_dev[v_index_u8]));
+		if (get_time_usec != BMP280_NULL &&
+		a_trigger_usec_u32 != BMP280_NULL)
+			a_trigger_usec_u32[v_index_u8] = get_time_usec();
+		if (a_dev[v_index_u8] != BMP280_NULL) {
+			v_meas_usec_u32 = bmp280_meas_time_usec(
+			a_dev[v_index_u8]->oversamp_temperature,
+			a_dev[v_index_u8]->oversamp_pressure);
+			if (v_meas_usec_u32 > *v_wait_usec_u32)
+				*v_wait_usec_u32 = v_meas_usec_u32;
+		}
+	}
+	return com_rslt;
+}
+/*!
+ *	@brief This API adds one synchronized trigger round
+ *	to the skew statistics
+ *	@note The skew of a round is the spread between the earliest
+ *	and the latest trigger timestamp of all devices in the round.
+ *
+ *
+ *
+ *  @param a_trigger_usec_u32 : Trigger time per device
+ *  @param v_count_u8 : Number of devices in the round
+ *  @param skew_stat : The statistics to update
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_sync_update_skew(
+const u32 a_trigger_usec_u32[], u8 v_count_u8,
+struct bmp280_skew_stat_t *skew_stat)
+{
+	u32 v_first_u32 = BMP280_ZERO_U8X;
+	u32 v_skew_u32 = BMP280_ZERO_U8X;
+	s32 v_diff_s32 = BMP280_ZERO_U8X;
+	u8 v_index_u8 = BMP280_ZERO_U8X;
+
+	if (a_trigger_usec_u32 == BMP280_NULL || skew_stat == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_count_u8 == BMP280_ZERO_U8X)
+		return SUCCESS;
+	/* earliest trigger, then the largest distance from it */
+	v_first_u32 = a_trigger_usec_u32[INDEX_ZERO];
+	for (v_index_u8 = BMP280_ONE_U8X; v_index_u8 < v_count_u8;
+	v_index_u8++)
+		if (BMP280_TIME_DIFF_USEC(a_trigger_usec_u32[v_index_u8],
+		v_first_u32) < BMP280_ZERO_U8X)
+			v_first_u32 = a_trigger_usec_u32[v_index_u8];
+	for (v_index_u8 = BMP280_ZERO_U8X; v_index_u8 < v_count_u8;
+	v_index_u8++) {
+		v_diff_s32 = BMP280_TIME_DIFF_USEC(
+		a_trigger_usec_u32[v_index_u8], v_first_u32);
+		if ((u32)v_diff_s32 > v_skew_u32)
+			v_skew_u32 = (u32)v_diff_s32;
+	}
+	if (skew_stat->count == BMP280_ZERO_U8X ||
+	v_skew_u32 < skew_stat->min_skew_usec)
+		skew_stat->min_skew_usec = v_skew_u32;
+	if (v_skew_u32 > skew_stat->max_skew_usec)
+		skew_stat->max_skew_usec = v_skew_u32;
+	if (v_skew_u32 > skew_stat->target_skew_usec)
+		skew_stat->over_target_count++;
+	skew_stat->last_skew_usec = v_skew_u32;
+	skew_stat->count++;
+	skew_stat->mean_skew_usec = (u32)bmp280_mean_update(
+	(s32)skew_stat->mean_skew_usec, &skew_stat->rem_skew_usec,
+	(s32)v_skew_u32, skew_stat->count);
+	return SUCCESS;
+}
+/*!
+ * @brief
+ *	This API write the data to
+ *	the given register
+ *
+ *
+ *	@param v_addr_u8 -> Address of the register
+ *	@param v_data_u8 -> The data from the register
+ *	@param v_len_u8 -> no of bytes to read
+ *
+ *	@note A write covering the ctrl_meas register 0xF4 reads the
+ *	oversampling back into the cache, one covering the config
+ *	register 0xF5 the filter setting.
+ *
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+ */
+BMP280_RETURN_FUNCTION_TYPE bmp280_write_register(u8 v_addr_u8,
+u8 *v_data_u8, u8 v_len_u8)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	u8 v_cache_u8 = BMP280_ZERO_U8X;
+	/* check the p_bmp280 struct pointer as NULL*/
+	if (p_bmp280 == BMP280_NULL) {
+		return  E_BMP280_NULL_PTR;
+		} else {
+			com_rslt = p_bmp280->BMP280_BUS_WRITE_FUNC(
+			p_bmp280->dev_addr,
+			v_addr_u8, v_data_u8, v_len_u8);
+			/* a direct ctrl_meas or config write may change
+			the oversampling or the filter, which select the
+			data read lengths */
+			if (com_rslt == SUCCESS &&
+			v_addr_u8 <= BMP280_CTRL_MEAS_REG &&
+			v_addr_u8 + v_len_u8 > BMP280_CTRL_MEAS_REG) {
+				com_rslt = bmp280_get_oversamp_temperature(
+				&v_cache_u8);
+				com_rslt = bmp280_first_error(com_rslt,
+				bmp280_get_oversamp_pressure(&v_cache_u8));
+			}
+			if (com_rslt == SUCCESS &&
+			v_addr_u8 <= BMP280_CONFIG_REG &&
+			v_addr_u8 + v_len_u8 > BMP280_CONFIG_REG)
+				com_rslt = bmp280_get_filter(&v_cache_u8);
+		}
+	return com_rslt;
+}
+/*!
+ * @brief
+ *	This API reads the data from
+ *	the given register
+ *
+ *
+ *	@param v_addr_u8 -> Address of the register
+ *	@param v_data_u8 -> The data from the register
+ *	@param v_len_u8 -> no of bytes to read
+ *
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+ */
+BMP280_RETURN_FUNCTION_TYPE bmp280_read_register(u8 v_addr_u8,
+u8 *v_data_u8, u8 v_len_u8)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	/* check the p_bmp280 struct pointer as NULL*/
+	if (p_bmp280 == BMP280_NULL) {
+		return  E_BMP280_NULL_PTR;
+		} else {
+			com_rslt = p_bmp280->BMP280_BUS_READ_FUNC(
+			p_bmp280->dev_addr,
+			v_addr_u8, v_data_u8, v_len_u8);
+		}
+	return com_rslt;
+}
+#ifdef BMP280_ENABLE_FLOAT
+/*!
+ * @brief This API used to read
+ * actual temperature from uncompensated temperature
+ * @note Returns the value in Degree centigrade
+ * @note Output value of "51.23" equals 51.23 DegC.
+ *
+ *
+ *
+ *  @param v_uncomp_temperature_s32 : value of uncompensated temperature
+ *
+ *
+ *
+ *  @return
+ *	Actual temperature in floating point
+ *
+*/
+double bmp280_compensate_T_double(s32 v_uncomp_temperature_s32)
+{
+	double v_x1_u32r = BMP280_ZERO_U8X;
+	double v_x2_u32r = BMP280_ZERO_U8X;
+	double temperature = BMP280_ZERO_U8X;
+
+	v_x1_u32r  = (((double)v_uncomp_temperature_s32)
 	/ BMP280_FLOAT_TRUE_TEMP_1_6_3_8_4_DATA -
 	((double)p_bmp280->calib_param.dig_T1)
 	/ BMP280_FLOAT_TRUE_TEMP_1_0_2_4_DATA) *
@@ -1491,3 +2138,4672 @@ BMP280_RETURN_FUNCTION_TYPE bmp280_compute_wait_time(u8
 	/ BMP280_SIXTEEN_U8X;
 	return com_rslt;
 }
+/*!
+ * @brief Computes the maximum duration of one measurement
+ * for the cached oversampling settings in microseconds
+ *
+ *
+ *
+ *
+ *  @param v_meas_time_u32: The value of measurement time in us
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+ */
+BMP280_RETURN_FUNCTION_TYPE bmp280_compute_meas_time_usec(
+u32 *v_meas_time_u32)
+{
+	/* check the p_bmp280 struct pointer as NULL*/
+	if (p_bmp280 == BMP280_NULL) {
+		return  E_BMP280_NULL_PTR;
+		} else {
+			*v_meas_time_u32 = bmp280_meas_time_usec(
+			p_bmp280->oversamp_temperature,
+			p_bmp280->oversamp_pressure);
+		}
+	return SUCCESS;
+}
+/*!
+ *	@brief Derives the stream cycle time from
+ *	the ctrl_meas and config register values
+ *	and restarts the phase estimation
+ *
+ *  @param stream : The stream reader state
+ *  @param v_ctrl_meas_u8 : The ctrl_meas register value
+ *  @param v_config_u8 : The config register value
+ *
+*/
+static void bmp280_stream_set_timing(struct bmp280_stream_t *stream,
+u8 v_ctrl_meas_u8, u8 v_config_u8)
+{
+	stream->ctrl_meas = v_ctrl_meas_u8;
+	stream->config = v_config_u8;
+	stream->meas_usec = bmp280_meas_time_usec(
+	BMP280_GET_BITSLICE(v_ctrl_meas_u8,
+	BMP280_CTRL_MEAS_REG_OVERSAMP_TEMPERATURE),
+	BMP280_GET_BITSLICE(v_ctrl_meas_u8,
+	BMP280_CTRL_MEAS_REG_OVERSAMP_PRESSURE));
+	stream->period_usec = stream->meas_usec +
+	a_bmp280_standby_usec_u32[BMP280_GET_BITSLICE(v_config_u8,
+	BMP280_CONFIG_REG_STANDBY_DURN)];
+	stream->guard_usec = stream->period_usec / BMP280_STREAM_GUARD_DIVIDER;
+	if (stream->guard_usec < BMP280_STREAM_GUARD_MIN_USEC)
+		stream->guard_usec = BMP280_STREAM_GUARD_MIN_USEC;
+	stream->probe_offset_usec = stream->guard_usec;
+	stream->started = BMP280_ZERO_U8X;
+	stream->bracketed = BMP280_ZERO_U8X;
+	stream->probing = BMP280_ZERO_U8X;
+	stream->anchored = BMP280_ZERO_U8X;
+	stream->probe_count = BMP280_ZERO_U8X;
+	stream->anchor_cycles = BMP280_ZERO_U8X;
+}
+/*!
+ *	@brief This API initializes the normal mode stream reader
+ *	from the ctrl_meas (0xF4) and config (0xF5) registers
+ *	@note The cycle time is the measurement time plus t_sb
+ *
+ *
+ *
+ *  @param stream : The stream reader state
+ *
+ *
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_stream_init(
+struct bmp280_stream_t *stream)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	/* Array holding the ctrl_meas and config registers
+	a_data_u8[0] - ctrl_meas
+	a_data_u8[1] - config
+	*/
+	u8 a_data_u8[ARRAY_SIZE_TWO] = {BMP280_ZERO_U8X, BMP280_ZERO_U8X};
+	/* check the p_bmp280 struct pointer as NULL*/
+	if (p_bmp280 == BMP280_NULL || stream == BMP280_NULL) {
+		return  E_BMP280_NULL_PTR;
+		} else {
+			com_rslt = p_bmp280->BMP280_BUS_READ_FUNC(
+			p_bmp280->dev_addr,
+			BMP280_CTRL_MEAS_REG, a_data_u8, BMP280_TWO_U8X);
+			if (com_rslt != SUCCESS)
+				return com_rslt;
+			bmp280_stream_set_timing(stream,
+			a_data_u8[INDEX_ZERO], a_data_u8[INDEX_ONE]);
+			stream->seq = BMP280_ZERO_U8X;
+			stream->read_count = BMP280_ZERO_U8X;
+			stream->duplicate_count = BMP280_ZERO_U8X;
+			stream->missed_count = BMP280_ZERO_U8X;
+		}
+	return com_rslt;
+}
+/*!
+ *	@brief This API returns the time until the next stream read is due
+ *
+ *
+ *
+ *  @param stream : The stream reader state
+ *  @param v_now_usec_u32 : The current time in us
+ *  @param v_wait_usec_u32 : The remaining wait time in us, 0 if due
+ *
+ *
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_stream_get_wait_usec(
+struct bmp280_stream_t *stream, u32 v_now_usec_u32,
+u32 *v_wait_usec_u32)
+{
+	s32 v_wait_s32 = BMP280_ZERO_U8X;
+
+	if (stream == BMP280_NULL || v_wait_usec_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (stream->started)
+		v_wait_s32 = BMP280_TIME_DIFF_USEC(stream->next_read_usec,
+		v_now_usec_u32);
+	*v_wait_usec_u32 = (v_wait_s32 > BMP280_ZERO_U8X) ?
+	(u32)v_wait_s32 : BMP280_ZERO_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief Stream read of the given device, see bmp280_stream_read()
+ *
+*/
+static BMP280_RETURN_FUNCTION_TYPE bmp280_dev_stream_read(
+struct bmp280_t *p_dev, struct bmp280_stream_t *stream, u32 v_now_usec_u32,
+struct bmp280_sample_t *sample, u8 *v_fresh_u8)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	/* Array holding the status, control and data registers
+	a_data_u8[0] - Status
+	a_data_u8[1] - ctrl_meas
+	a_data_u8[2] - config
+	a_data_u8[3] - reserved
+	a_data_u8[4] to a_data_u8[6] - Pressure
+	a_data_u8[7] to a_data_u8[9] - Temperature
+	*/
+	u8 a_data_u8[BMP280_STREAM_DATA_LEN] = {BMP280_ZERO_U8X};
+	s32 v_uncomp_pressure_s32 = BMP280_ZERO_U8X;
+	s32 v_uncomp_temperature_s32 = BMP280_ZERO_U8X;
+	s32 v_elapsed_s32 = BMP280_ZERO_U8X;
+	s32 v_error_s32 = BMP280_ZERO_U8X;
+	u32 v_cycles_u32 = BMP280_ONE_U8X;
+	u32 v_end_usec_u32 = BMP280_ZERO_U8X;
+	if (p_dev == BMP280_NULL || stream == BMP280_NULL ||
+	sample == BMP280_NULL || v_fresh_u8 == BMP280_NULL)
+		return  E_BMP280_NULL_PTR;
+	*v_fresh_u8 = BMP280_ZERO_U8X;
+	com_rslt = p_dev->BMP280_BUS_READ_FUNC(p_dev->dev_addr,
+	BMP280_STAT_REG, a_data_u8, BMP280_STREAM_DATA_LEN);
+	if (com_rslt != SUCCESS)
+		return com_rslt;
+	stream->read_count++;
+	/* a configuration change invalidates the timing model */
+	if (a_data_u8[INDEX_ONE] != stream->ctrl_meas ||
+	a_data_u8[INDEX_TWO] != stream->config)
+		bmp280_stream_set_timing(stream,
+		a_data_u8[INDEX_ONE], a_data_u8[INDEX_TWO]);
+	v_uncomp_pressure_s32 = bmp280_decode_uncomp(
+	&a_data_u8[INDEX_FOUR]);
+	v_uncomp_temperature_s32 = bmp280_decode_uncomp(
+	&a_data_u8[INDEX_SEVEN]);
+	v_elapsed_s32 = BMP280_TIME_DIFF_USEC(v_now_usec_u32,
+	stream->phase_usec);
+
+	if (stream->started &&
+	v_uncomp_pressure_s32 == stream->last_uncomp_pressure &&
+	v_uncomp_temperature_s32 == stream->last_uncomp_temperature &&
+	a_data_u8[INDEX_ZERO] == stream->last_status &&
+	v_elapsed_s32 < (s32)(stream->period_usec +
+	(stream->period_usec >> SHIFT_RIGHT_1_POSITION))) {
+		/* conversion not finished yet, retry with growing backoff */
+		stream->duplicate_count++;
+		stream->retry_usec = stream->bracketed ?
+		(stream->retry_usec << SHIFT_LEFT_1_POSITION) :
+		stream->guard_usec;
+		stream->bracketed = BMP280_ONE_U8X;
+		stream->bracket_usec = v_now_usec_u32;
+		stream->next_read_usec = v_now_usec_u32 + stream->retry_usec;
+		return com_rslt;
+	}
+
+	if (!stream->started) {
+		stream->started = BMP280_ONE_U8X;
+		stream->phase_usec = v_now_usec_u32;
+		/* probe at once to locate the conversion end */
+		stream->probe_count = BMP280_STREAM_PROBE_INTERVAL;
+	} else {
+		if (v_elapsed_s32 > (s32)(stream->period_usec >>
+		SHIFT_RIGHT_1_POSITION))
+			v_cycles_u32 = ((u32)v_elapsed_s32 +
+			(stream->period_usec >> SHIFT_RIGHT_1_POSITION)) /
+			stream->period_usec;
+		stream->missed_count += v_cycles_u32 - BMP280_ONE_U8X;
+		stream->anchor_cycles += v_cycles_u32;
+		if (stream->bracketed) {
+			/* the conversion ended between the two reads */
+			v_end_usec_u32 = stream->bracket_usec +
+			((v_now_usec_u32 - stream->bracket_usec)
+			>> SHIFT_RIGHT_1_POSITION);
+			if (stream->anchored) {
+				v_error_s32 = BMP280_TIME_DIFF_USEC(
+				v_end_usec_u32, stream->anchor_usec +
+				stream->anchor_cycles * stream->period_usec);
+				stream->period_usec = (u32)(
+				(s32)stream->period_usec + ((v_error_s32 /
+				(s32)stream->anchor_cycles) >>
+				BMP280_STREAM_PERIOD_GAIN_SHIFT));
+			}
+			stream->anchored = BMP280_ONE_U8X;
+			stream->anchor_usec = v_end_usec_u32;
+			stream->anchor_cycles = BMP280_ZERO_U8X;
+			stream->phase_usec = v_end_usec_u32;
+		} else if (stream->probing) {
+			/* fresh already at the early probe: move earlier
+			and keep probing with a growing offset until a
+			duplicate brackets the conversion end */
+			stream->phase_usec = v_now_usec_u32 -
+			stream->probe_offset_usec;
+			stream->probe_offset_usec <<= SHIFT_LEFT_1_POSITION;
+			if (stream->probe_offset_usec >
+			(stream->period_usec >> SHIFT_RIGHT_1_POSITION))
+				stream->probe_offset_usec =
+				stream->period_usec >> SHIFT_RIGHT_1_POSITION;
+			stream->probe_count = BMP280_STREAM_PROBE_INTERVAL;
+		} else {
+			stream->phase_usec += v_cycles_u32 *
+			stream->period_usec;
+		}
+	}
+	if (stream->bracketed || !stream->probing)
+		stream->probe_offset_usec = stream->guard_usec;
+	stream->bracketed = BMP280_ZERO_U8X;
+	stream->probing = BMP280_ZERO_U8X;
+	if (++stream->probe_count >= BMP280_STREAM_PROBE_INTERVAL) {
+		stream->probe_count = BMP280_ZERO_U8X;
+		stream->probing = BMP280_ONE_U8X;
+		stream->next_read_usec = stream->phase_usec +
+		stream->period_usec - stream->probe_offset_usec;
+	} else {
+		stream->next_read_usec = stream->phase_usec +
+		stream->period_usec + stream->guard_usec;
+	}
+
+	stream->last_uncomp_pressure = v_uncomp_pressure_s32;
+	stream->last_uncomp_temperature = v_uncomp_temperature_s32;
+	stream->last_status = a_data_u8[INDEX_ZERO];
+
+	sample->uncomp_pressure = v_uncomp_pressure_s32;
+	sample->uncomp_temperature = v_uncomp_temperature_s32;
+	bmp280_calib_compensate_memo(&p_dev->calib_param, &p_dev->memo,
+	v_uncomp_temperature_s32, v_uncomp_pressure_s32,
+	&sample->temperature, &sample->pressure);
+	sample->timestamp_usec = v_now_usec_u32;
+	sample->status = a_data_u8[INDEX_ZERO];
+	sample->seq = ++stream->seq;
+	*v_fresh_u8 = BMP280_ONE_U8X;
+	return com_rslt;
+}
+/*!
+ *	@brief This API reads status and data registers (0xF3 to 0xFC)
+ *	in one burst and reports whether the data is a new conversion
+ *	@note A read is a duplicate when raw pressure, raw temperature and
+ *	status equal the previous read and less than one and a half
+ *	cycles have passed since the estimated end of the last conversion.
+ *	@note Fresh samples are numbered consecutively and compensated,
+ *	duplicates leave the sample untouched.
+ *	@note Reads are scheduled just after the estimated end of each
+ *	conversion; the estimate is corrected whenever a duplicate brackets
+ *	the conversion end, and every BMP280_STREAM_PROBE_INTERVAL samples
+ *	one read is placed early on purpose to track clock drift.
+ *
+ *
+ *
+ *  @param stream : The stream reader state
+ *  @param v_now_usec_u32 : The current time in us
+ *  @param sample : The sample to fill
+ *  @param v_fresh_u8 : 1 for a new conversion, 0 for a duplicate
+ *
+ *
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_stream_read(
+struct bmp280_stream_t *stream, u32 v_now_usec_u32,
+struct bmp280_sample_t *sample, u8 *v_fresh_u8)
+{
+	return bmp280_dev_stream_read(p_bmp280, stream, v_now_usec_u32,
+	sample, v_fresh_u8);
+}
+/*!
+ *	@brief Compares the deadlines of two heap entries
+ *
+ *  @return non zero if a is due before b
+ *
+*/
+static u8 bmp280_engine_before(const struct bmp280_async_t *a,
+const struct bmp280_async_t *b)
+{
+	return BMP280_TIME_DIFF_USEC(a->deadline_usec, b->deadline_usec)
+	< BMP280_ZERO_U8X;
+}
+/*!
+ *	@brief Places a heap entry at the given position
+ *
+*/
+static void bmp280_engine_place(struct bmp280_engine_t *engine,
+u16 v_index_u16, struct bmp280_async_t *async)
+{
+	engine->heap[v_index_u16] = async;
+	async->heap_index = v_index_u16;
+}
+/*!
+ *	@brief Restores the heap order around one entry
+ *
+ *  @param engine : The engine
+ *  @param v_index_u16 : Position of the entry that changed
+ *
+*/
+static void bmp280_engine_sift(struct bmp280_engine_t *engine,
+u16 v_index_u16)
+{
+	struct bmp280_async_t *async = engine->heap[v_index_u16];
+	u16 v_parent_u16 = BMP280_ZERO_U8X;
+	u16 v_child_u16 = BMP280_ZERO_U8X;
+
+	/* move up while earlier than the parent */
+	while (v_index_u16 > BMP280_ZERO_U8X) {
+		v_parent_u16 = (v_index_u16 - BMP280_ONE_U8X) >>
+		SHIFT_RIGHT_1_POSITION;
+		if (!bmp280_engine_before(async, engine->heap[v_parent_u16]))
+			break;
+		bmp280_engine_place(engine, v_index_u16,
+		engine->heap[v_parent_u16]);
+		v_index_u16 = v_parent_u16;
+	}
+	/* move down while later than the earliest child */
+	for (;;) {
+		v_child_u16 = (v_index_u16 << SHIFT_LEFT_1_POSITION) +
+		BMP280_ONE_U8X;
+		if (v_child_u16 >= engine->count)
+			break;
+		if (v_child_u16 + BMP280_ONE_U8X < engine->count &&
+		bmp280_engine_before(engine->heap[v_child_u16 +
+		BMP280_ONE_U8X], engine->heap[v_child_u16]))
+			v_child_u16++;
+		if (!bmp280_engine_before(engine->heap[v_child_u16], async))
+			break;
+		bmp280_engine_place(engine, v_index_u16,
+		engine->heap[v_child_u16]);
+		v_index_u16 = v_child_u16;
+	}
+	bmp280_engine_place(engine, v_index_u16, async);
+}
+/*!
+ *	@brief Schedules the next trigger of a sensor on its interval
+ *	grid, skipping slots that are already in the past
+ *
+ *  @param engine : The engine
+ *  @param async : The sensor, at the top of the heap
+ *  @param v_now_usec_u32 : The current time in us
+ *
+*/
+static void bmp280_engine_next_slot(struct bmp280_engine_t *engine,
+struct bmp280_async_t *async, u32 v_now_usec_u32)
+{
+	async->state = BMP280_ASYNC_STATE_IDLE;
+	async->deadline_usec = async->slot_usec + async->interval_usec;
+	while (async->interval_usec != BMP280_ZERO_U8X &&
+	BMP280_TIME_DIFF_USEC(async->deadline_usec,
+	v_now_usec_u32) < BMP280_ZERO_U8X) {
+		async->deadline_usec += async->interval_usec;
+		async->overrun_count++;
+	}
+	bmp280_engine_sift(engine, async->heap_index);
+}
+/*!
+ *	@brief This API initializes an acquisition engine
+ *	on caller provided heap storage
+ *
+ *
+ *
+ *  @param engine : The engine
+ *  @param a_heap : Storage for v_capacity_u16 sensor pointers
+ *  @param v_capacity_u16 : Maximum number of sensors
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_engine_init(
+struct bmp280_engine_t *engine, struct bmp280_async_t **a_heap,
+u16 v_capacity_u16)
+{
+	if (engine == BMP280_NULL || a_heap == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	engine->heap = a_heap;
+	engine->count = BMP280_ZERO_U8X;
+	engine->capacity = v_capacity_u16;
+	engine->event_count = BMP280_ZERO_U8X;
+	engine->max_late_usec = BMP280_ZERO_U8X;
+	engine->mean_late_usec = BMP280_ZERO_U8X;
+	engine->late_fixed = BMP280_ZERO_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API adds a sensor to the engine; its first
+ *	forced measurement is triggered at v_start_usec_u32
+ *	@note dev, interval_usec, sample_cb, ring and hub (or
+ *	BMP280_NULL) have to be set before
+ *
+ *
+ *
+ *  @param engine : The engine
+ *  @param async : The sensor
+ *  @param v_start_usec_u32 : Time of the first trigger in us
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Engine full
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_engine_add(
+struct bmp280_engine_t *engine, struct bmp280_async_t *async,
+u32 v_start_usec_u32)
+{
+	if (engine == BMP280_NULL || async == BMP280_NULL ||
+	async->dev == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (engine->count >= engine->capacity)
+		return E_BMP280_OUT_OF_RANGE;
+	async->state = BMP280_ASYNC_STATE_IDLE;
+	async->deadline_usec = v_start_usec_u32;
+	async->slot_usec = v_start_usec_u32;
+	async->trigger_usec = v_start_usec_u32;
+	async->seq = BMP280_ZERO_U8X;
+	async->overrun_count = BMP280_ZERO_U8X;
+	bmp280_engine_place(engine, engine->count++, async);
+	bmp280_engine_sift(engine, async->heap_index);
+	return SUCCESS;
+}
+/*!
+ *	@brief This API removes a sensor from the engine
+ *
+ *
+ *
+ *  @param engine : The engine
+ *  @param async : The sensor
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Sensor not in the engine
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_engine_remove(
+struct bmp280_engine_t *engine, struct bmp280_async_t *async)
+{
+	u16 v_index_u16 = BMP280_ZERO_U8X;
+
+	if (engine == BMP280_NULL || async == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	v_index_u16 = async->heap_index;
+	if (v_index_u16 >= engine->count ||
+	engine->heap[v_index_u16] != async)
+		return E_BMP280_OUT_OF_RANGE;
+	engine->count--;
+	if (v_index_u16 != engine->count) {
+		bmp280_engine_place(engine, v_index_u16,
+		engine->heap[engine->count]);
+		bmp280_engine_sift(engine, v_index_u16);
+	}
+	async->heap_index = BMP280_ENGINE_INDEX_NONE;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API returns the earliest deadline of all sensors
+ *
+ *
+ *
+ *  @param engine : The engine
+ *  @param v_deadline_usec_u32 : The earliest deadline in us
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> No sensor in the engine
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_engine_next_deadline(
+struct bmp280_engine_t *engine, u32 *v_deadline_usec_u32)
+{
+	if (engine == BMP280_NULL || v_deadline_usec_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (engine->count == BMP280_ZERO_U8X)
+		return E_BMP280_OUT_OF_RANGE;
+	*v_deadline_usec_u32 = engine->heap[INDEX_ZERO]->deadline_usec;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API processes every trigger and read
+ *	that is due at v_now_usec_u32 and never blocks
+ *	@note An idle sensor is triggered in forced mode and its read
+ *	is scheduled after the measurement time; a converting sensor is
+ *	read, compensated, pushed to its ring if one is attached and
+ *	handed to its callback, and its next
+ *	trigger is scheduled on the interval grid. A failed trigger or
+ *	read only reaches the callback, with a NULL sample. Slots that
+ *	are already in the past are skipped and counted as overruns.
+ *	@note Each event costs O(log n), so one thread can serve
+ *	thousands of sensors when it sleeps until the next deadline,
+ *	e.g. on a timerfd armed with bmp280_engine_next_deadline().
+ *
+ *
+ *
+ *  @param engine : The engine
+ *  @param v_now_usec_u32 : The current time in us
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_engine_run(
+struct bmp280_engine_t *engine, u32 v_now_usec_u32)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = SUCCESS;
+	BMP280_RETURN_FUNCTION_TYPE v_rslt_s8 = SUCCESS;
+	struct bmp280_async_t *async = BMP280_NULL;
+	struct bmp280_sample_t sample;
+	s32 v_late_s32 = BMP280_ZERO_U8X;
+
+	if (engine == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	while (engine->count > BMP280_ZERO_U8X) {
+		async = engine->heap[INDEX_ZERO];
+		v_late_s32 = BMP280_TIME_DIFF_USEC(v_now_usec_u32,
+		async->deadline_usec);
+		if (v_late_s32 < BMP280_ZERO_U8X)
+			break;
+		engine->event_count++;
+		if ((u32)v_late_s32 > engine->max_late_usec)
+			engine->max_late_usec = (u32)v_late_s32;
+		/* the mean is kept with fractional bits, an integer
+		running mean would stall up to a window away from it;
+		the clamp keeps the fixed point value in s32 */
+		if (v_late_s32 > BMP280_ENGINE_MEAN_MAX_LATE_USEC)
+			v_late_s32 = BMP280_ENGINE_MEAN_MAX_LATE_USEC;
+		engine->late_fixed += (v_late_s32 *
+		BMP280_ENGINE_MEAN_WINDOW - engine->late_fixed) /
+		(s32)(engine->event_count < BMP280_ENGINE_MEAN_WINDOW ?
+		engine->event_count : BMP280_ENGINE_MEAN_WINDOW);
+		engine->mean_late_usec = (u32)(engine->late_fixed /
+		BMP280_ENGINE_MEAN_WINDOW);
+		if (async->state == BMP280_ASYNC_STATE_IDLE) {
+			v_rslt_s8 = bmp280_dev_trigger_forced(async->dev);
+			async->slot_usec = async->deadline_usec;
+			async->trigger_usec = v_now_usec_u32;
+			if (v_rslt_s8 == SUCCESS) {
+				async->state = BMP280_ASYNC_STATE_CONVERTING;
+				async->deadline_usec = v_now_usec_u32 +
+				bmp280_meas_time_usec(
+				async->dev->oversamp_temperature,
+				async->dev->oversamp_pressure);
+				bmp280_engine_sift(engine, INDEX_ZERO);
+			} else {
+				/* report the failed trigger, retry next slot */
+				bmp280_engine_next_slot(engine, async,
+				v_now_usec_u32);
+				if (async->sample_cb != BMP280_NULL)
+					async->sample_cb(async, BMP280_NULL,
+					v_rslt_s8);
+			}
+		} else {
+			v_rslt_s8 = bmp280_dev_read_uncomp(async->dev,
+			&sample.uncomp_pressure, &sample.uncomp_temperature);
+			if (v_rslt_s8 != SUCCESS) {
+				/* nothing of a failed read is published */
+				bmp280_engine_next_slot(engine, async,
+				v_now_usec_u32);
+				if (async->sample_cb != BMP280_NULL)
+					async->sample_cb(async, BMP280_NULL,
+					v_rslt_s8);
+				com_rslt = bmp280_first_error(com_rslt,
+				v_rslt_s8);
+				continue;
+			}
+			bmp280_calib_compensate_memo(&async->dev->calib_param,
+			&async->dev->memo, sample.uncomp_temperature,
+			sample.uncomp_pressure, &sample.temperature,
+			&sample.pressure);
+			sample.timestamp_usec = async->trigger_usec;
+			sample.status = BMP280_ZERO_U8X;
+			sample.seq = ++async->seq;
+			bmp280_engine_next_slot(engine, async, v_now_usec_u32);
+			if (async->ring != BMP280_NULL)
+				bmp280_ring_push(async->ring, &sample);
+			if (async->hub != BMP280_NULL)
+				bmp280_hub_publish(async->hub, &sample);
+			/* the heap is consistent, so the callback
+			may add or remove sensors */
+			if (async->sample_cb != BMP280_NULL)
+				async->sample_cb(async, &sample, v_rslt_s8);
+		}
+		com_rslt = bmp280_first_error(com_rslt, v_rslt_s8);
+	}
+	return com_rslt;
+}
+/*!
+ *	@brief Timer callback of a forced mode operation:
+ *	reads the finished conversion and completes the operation
+ *
+ *  @param arg : The operation
+ *
+*/
+static void bmp280_op_forced_done(void *arg)
+{
+	struct bmp280_op_t *op = (struct bmp280_op_t *)arg;
+	struct bmp280_sample_t *sample = &op->sample;
+
+	op->com_rslt = bmp280_dev_read_uncomp(op->dev,
+	&sample->uncomp_pressure, &sample->uncomp_temperature);
+	/* a failed read completes with the error and no new sample */
+	if (op->com_rslt == SUCCESS) {
+		bmp280_calib_compensate_memo(&op->dev->calib_param,
+		&op->dev->memo, sample->uncomp_temperature,
+		sample->uncomp_pressure, &sample->temperature,
+		&sample->pressure);
+		sample->status = BMP280_ZERO_U8X;
+		sample->seq++;
+	}
+	op->complete(op);
+}
+/*!
+ *	@brief Timer callback of a normal mode operation:
+ *	reads the stream and completes the operation on a fresh
+ *	sample, or re-arms the timer on a duplicate
+ *
+ *  @param arg : The operation
+ *
+*/
+static void bmp280_op_stream_due(void *arg)
+{
+	struct bmp280_op_t *op = (struct bmp280_op_t *)arg;
+	u32 v_now_usec_u32 = op->timer->get_time_usec(op->timer->context);
+	u8 v_fresh_u8 = BMP280_ZERO_U8X;
+
+	op->com_rslt = bmp280_dev_stream_read(op->dev, op->stream,
+	v_now_usec_u32, &op->sample, &v_fresh_u8);
+	if (op->com_rslt == SUCCESS && !v_fresh_u8)
+		op->timer->schedule(op->timer->context,
+		op->stream->next_read_usec, bmp280_op_stream_due, op);
+	else
+		op->complete(op);
+}
+/*!
+ *	@brief This API starts a forced mode measurement as an
+ *	asynchronous operation; instead of calling delay_msec the
+ *	operation arms the timer for the end of the conversion and
+ *	calls op->complete with the compensated sample in op->sample
+ *	@note The operation is owned by the caller and nothing is
+ *	allocated, so it can be embedded in a coroutine frame or taken
+ *	from a struct bmp280_op_pool_t. A C++20 awaitable only has to
+ *	store the coroutine handle in op->user_data and resume it from
+ *	op->complete. When the read fails op->com_rslt holds the error
+ *	and the compensated values and seq of op->sample are kept.
+ *
+ *
+ *
+ *  @param op : The operation, with dev, timer and complete set
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error, op->complete is not called
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_op_forced_measure(struct bmp280_op_t *op)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	u32 v_now_usec_u32 = BMP280_ZERO_U8X;
+
+	if (op == BMP280_NULL || op->dev == BMP280_NULL ||
+	op->timer == BMP280_NULL || op->complete == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	com_rslt = bmp280_dev_trigger_forced(op->dev);
+	if (com_rslt != SUCCESS)
+		return com_rslt;
+	v_now_usec_u32 = op->timer->get_time_usec(op->timer->context);
+	op->sample.timestamp_usec = v_now_usec_u32;
+	op->timer->schedule(op->timer->context, v_now_usec_u32 +
+	bmp280_meas_time_usec(op->dev->oversamp_temperature,
+	op->dev->oversamp_pressure), bmp280_op_forced_done, op);
+	return com_rslt;
+}
+/*!
+ *	@brief This API waits asynchronously for the next fresh
+ *	normal mode sample of op->stream; the timer is armed for the
+ *	next scheduled stream read and op->complete is called once a
+ *	new conversion has been read, see bmp280_stream_read()
+ *
+ *
+ *
+ *  @param op : The operation, with dev, stream, timer and complete set
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_op_next_sample(struct bmp280_op_t *op)
+{
+	if (op == BMP280_NULL || op->dev == BMP280_NULL ||
+	op->stream == BMP280_NULL || op->timer == BMP280_NULL ||
+	op->complete == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	op->timer->schedule(op->timer->context,
+	op->stream->started ? op->stream->next_read_usec :
+	op->timer->get_time_usec(op->timer->context),
+	bmp280_op_stream_due, op);
+	return SUCCESS;
+}
+/*!
+ *	@brief This API initializes a free list of operations
+ *
+ *
+ *
+ *  @param pool : The pool
+ *  @param a_op : Storage for the operations
+ *  @param v_count_u16 : Number of operations in the storage
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_op_pool_init(
+struct bmp280_op_pool_t *pool, struct bmp280_op_t *a_op,
+u16 v_count_u16)
+{
+	u16 v_index_u16 = BMP280_ZERO_U8X;
+
+	if (pool == BMP280_NULL || (a_op == BMP280_NULL &&
+	v_count_u16 != BMP280_ZERO_U8X))
+		return E_BMP280_NULL_PTR;
+	pool->free_list = BMP280_NULL;
+	for (v_index_u16 = v_count_u16; v_index_u16 > BMP280_ZERO_U8X;
+	v_index_u16--) {
+		a_op[v_index_u16 - BMP280_ONE_U8X].next_free = pool->free_list;
+		pool->free_list = &a_op[v_index_u16 - BMP280_ONE_U8X];
+	}
+	return SUCCESS;
+}
+/*!
+ *	@brief This API takes an operation from the pool
+ *
+ *
+ *
+ *  @param pool : The pool
+ *
+ *
+ *  @return the operation, or NULL when the pool is empty
+ *
+ *
+*/
+struct bmp280_op_t *bmp280_op_pool_get(struct bmp280_op_pool_t *pool)
+{
+	struct bmp280_op_t *op = BMP280_NULL;
+
+	if (pool != BMP280_NULL && pool->free_list != BMP280_NULL) {
+		op = pool->free_list;
+		pool->free_list = op->next_free;
+		op->next_free = BMP280_NULL;
+	}
+	return op;
+}
+/*!
+ *	@brief This API returns an operation to the pool
+ *
+ *
+ *
+ *  @param pool : The pool
+ *  @param op : The operation, must not be pending
+ *
+ *
+ *  @return nothing
+ *
+ *
+*/
+void bmp280_op_pool_put(struct bmp280_op_pool_t *pool,
+struct bmp280_op_t *op)
+{
+	if (pool != BMP280_NULL && op != BMP280_NULL) {
+		op->next_free = pool->free_list;
+		pool->free_list = op;
+	}
+}
+/*!
+ *	@brief This API initializes a single producer,
+ *	single consumer sample ring on caller provided storage
+ *
+ *
+ *
+ *  @param ring : The ring
+ *  @param a_buffer : Storage for v_capacity_u32 samples
+ *  @param v_capacity_u32 : Number of samples, a power of two
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Capacity is not a power of two
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_ring_init(struct bmp280_ring_t *ring,
+struct bmp280_sample_t *a_buffer, u32 v_capacity_u32)
+{
+	if (ring == BMP280_NULL || a_buffer == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_capacity_u32 == BMP280_ZERO_U8X ||
+	(v_capacity_u32 & (v_capacity_u32 - BMP280_ONE_U8X)))
+		return E_BMP280_OUT_OF_RANGE;
+	ring->head = BMP280_ZERO_U8X;
+	ring->tail_cache = BMP280_ZERO_U8X;
+	ring->drop_count = BMP280_ZERO_U8X;
+	ring->tail = BMP280_ZERO_U8X;
+	ring->head_cache = BMP280_ZERO_U8X;
+	ring->buffer = a_buffer;
+	ring->mask = v_capacity_u32 - BMP280_ONE_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API appends one sample to the ring;
+ *	called by the producer only
+ *	@note The producer never waits: a full ring drops the
+ *	new sample and counts it in drop_count.
+ *
+ *
+ *
+ *  @param ring : The ring
+ *  @param sample : The sample to copy into the ring
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Ring full, sample dropped
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_ring_push(struct bmp280_ring_t *ring,
+const struct bmp280_sample_t *sample)
+{
+	u32 v_head_u32 = BMP280_ZERO_U8X;
+
+	if (ring == BMP280_NULL || sample == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	v_head_u32 = ring->head;
+	if (v_head_u32 - ring->tail_cache > ring->mask) {
+		/* only re-read the consumer line when looking full */
+		ring->tail_cache = ring->tail;
+		BMP280_MEMORY_BARRIER();
+		if (v_head_u32 - ring->tail_cache > ring->mask) {
+			ring->drop_count++;
+			return E_BMP280_OUT_OF_RANGE;
+		}
+	}
+	ring->buffer[v_head_u32 & ring->mask] = *sample;
+	/* publish the slot before the index */
+	BMP280_MEMORY_BARRIER();
+	ring->head = v_head_u32 + BMP280_ONE_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API removes up to v_max_u32 samples from the ring
+ *	in one batch; called by the consumer only
+ *
+ *
+ *
+ *  @param ring : The ring
+ *  @param a_sample : Destination for the samples
+ *  @param v_max_u32 : Size of the destination
+ *  @param v_count_u32 : Number of samples copied
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_ring_pop_batch(
+struct bmp280_ring_t *ring, struct bmp280_sample_t *a_sample,
+u32 v_max_u32, u32 *v_count_u32)
+{
+	u32 v_tail_u32 = BMP280_ZERO_U8X;
+	u32 v_avail_u32 = BMP280_ZERO_U8X;
+	u32 v_index_u32 = BMP280_ZERO_U8X;
+
+	if (ring == BMP280_NULL || a_sample == BMP280_NULL ||
+	v_count_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	v_tail_u32 = ring->tail;
+	v_avail_u32 = ring->head_cache - v_tail_u32;
+	if (v_avail_u32 < v_max_u32) {
+		/* only re-read the producer line when running short */
+		ring->head_cache = ring->head;
+		BMP280_MEMORY_BARRIER();
+		v_avail_u32 = ring->head_cache - v_tail_u32;
+	}
+	if (v_avail_u32 > v_max_u32)
+		v_avail_u32 = v_max_u32;
+	for (v_index_u32 = BMP280_ZERO_U8X; v_index_u32 < v_avail_u32;
+	v_index_u32++)
+		a_sample[v_index_u32] =
+		ring->buffer[(v_tail_u32 + v_index_u32) & ring->mask];
+	/* release the slots only after they have been copied */
+	BMP280_MEMORY_BARRIER();
+	ring->tail = v_tail_u32 + v_avail_u32;
+	*v_count_u32 = v_avail_u32;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API compensates a batch of samples of one device
+ *	from their uncomp_pressure and uncomp_temperature fields
+ *	@note The global device is not used and the calibration is
+ *	not modified, so several threads may compensate samples of
+ *	the same or different devices at the same time.
+ *
+ *
+ *
+ *  @param calib : Calibration data of the device
+ *  @param a_sample : The samples, temperature and pressure are written
+ *  @param v_count_u32 : Number of samples
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_compensate_samples(
+const struct bmp280_calib_param_t *calib,
+struct bmp280_sample_t *a_sample, u32 v_count_u32)
+{
+	/* t_fine and the memo of the batch live in private copies */
+	struct bmp280_calib_param_t calib_local;
+	struct bmp280_comp_memo_t memo;
+	u32 v_index_u32 = BMP280_ZERO_U8X;
+
+	if (calib == BMP280_NULL || a_sample == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	calib_local = *calib;
+	memo.valid = BMP280_ZERO_U8X;
+	for (v_index_u32 = BMP280_ZERO_U8X; v_index_u32 < v_count_u32;
+	v_index_u32++)
+		bmp280_calib_compensate_memo(&calib_local, &memo,
+		a_sample[v_index_u32].uncomp_temperature,
+		a_sample[v_index_u32].uncomp_pressure,
+		&a_sample[v_index_u32].temperature,
+		&a_sample[v_index_u32].pressure);
+	return SUCCESS;
+}
+/*!
+ *	@brief This API initializes a shared bus
+ *
+ *
+ *
+ *  @param bus : The bus
+ *  @param get_time_usec : Monotonic time in us, used to time waits
+ *  @param lock : Optional queue lock, BMP280_NULL when a single
+ *	thread submits and services
+ *  @param unlock : Optional queue unlock
+ *  @param lock_context : Argument of lock and unlock
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_bus_init(struct bmp280_bus_t *bus,
+u32 (*get_time_usec)(void), void (*lock)(void *context),
+void (*unlock)(void *context), void *lock_context)
+{
+	if (bus == BMP280_NULL || get_time_usec == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	bus->head = BMP280_NULL;
+	bus->tail = BMP280_NULL;
+	bus->get_time_usec = get_time_usec;
+	bus->lock = lock;
+	bus->unlock = unlock;
+	bus->lock_context = lock_context;
+	bus->count = BMP280_ZERO_U8X;
+	bus->txn_count = BMP280_ZERO_U8X;
+	bus->max_latency_usec = BMP280_ZERO_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API starts an empty transaction for a device
+ *
+ *
+ *
+ *  @param txn : The transaction
+ *  @param p_dev : The device
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_txn_init(struct bmp280_txn_t *txn,
+struct bmp280_t *p_dev)
+{
+	if (txn == BMP280_NULL || p_dev == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	txn->dev = p_dev;
+	txn->step_count = BMP280_ZERO_U8X;
+	txn->step_index = BMP280_ZERO_U8X;
+	txn->com_rslt = SUCCESS;
+	txn->next = BMP280_NULL;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API appends a step to a transaction
+ *
+ *
+ *
+ *  @param txn : The transaction
+ *  @param v_type_u8 : BMP280_XFER_WRITE, BMP280_XFER_READ
+ *	or BMP280_XFER_WAIT
+ *  @param v_reg_addr_u8 : Register address of a read or write
+ *  @param a_data_u8 : Data of a read or write, it has to stay
+ *	valid until the transaction is done
+ *  @param v_len_u8 : Number of bytes of a read or write
+ *  @param v_wait_usec_u32 : Duration of a wait
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Too many steps
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_txn_add_step(struct bmp280_txn_t *txn,
+u8 v_type_u8, u8 v_reg_addr_u8, u8 *a_data_u8, u8 v_len_u8,
+u32 v_wait_usec_u32)
+{
+	struct bmp280_xfer_t *step = BMP280_NULL;
+
+	if (txn == BMP280_NULL ||
+	(v_type_u8 != BMP280_XFER_WAIT && a_data_u8 == BMP280_NULL))
+		return E_BMP280_NULL_PTR;
+	if (txn->step_count >= BMP280_TXN_MAX_STEPS ||
+	v_type_u8 > BMP280_XFER_WAIT)
+		return E_BMP280_OUT_OF_RANGE;
+	step = &txn->step[txn->step_count++];
+	step->type = v_type_u8;
+	step->reg_addr = v_reg_addr_u8;
+	step->data = a_data_u8;
+	step->len = v_len_u8;
+	step->wait_usec = v_wait_usec_u32;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API builds a complete forced measurement:
+ *	trigger, wait for the conversion and read the data
+ *	@note Read the result with bmp280_txn_get_uncomp_pressure_temperature
+ *	once the transaction is done.
+ *
+ *
+ *
+ *  @param txn : The transaction
+ *  @param p_dev : The device
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_txn_forced(struct bmp280_txn_t *txn,
+struct bmp280_t *p_dev)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+
+	com_rslt = bmp280_txn_init(txn, p_dev);
+	if (com_rslt != SUCCESS)
+		return com_rslt;
+	txn->data[INDEX_ZERO] = (p_dev->oversamp_temperature
+	<< SHIFT_LEFT_5_POSITION) +
+	(p_dev->oversamp_pressure << SHIFT_LEFT_2_POSITION) +
+	BMP280_FORCED_MODE;
+	com_rslt = bmp280_txn_add_step(txn, BMP280_XFER_WRITE,
+	BMP280_CTRL_MEAS_REG, &txn->data[INDEX_ZERO], BMP280_ONE_U8X,
+	BMP280_ZERO_U8X);
+	com_rslt = bmp280_first_error(com_rslt,
+	bmp280_txn_add_step(txn, BMP280_XFER_WAIT,
+	BMP280_ZERO_U8X, BMP280_NULL, BMP280_ZERO_U8X,
+	bmp280_meas_time_usec(p_dev->oversamp_temperature,
+	p_dev->oversamp_pressure)));
+	/* a skipped temperature XLSB has to decode as zero */
+	txn->data[BMP280_TXN_FORCED_DATA_INDEX + INDEX_FIVE] =
+	BMP280_ZERO_U8X;
+	com_rslt = bmp280_first_error(com_rslt,
+	bmp280_txn_add_step(txn, BMP280_XFER_READ,
+	BMP280_PRESSURE_MSB_REG,
+	&txn->data[BMP280_TXN_FORCED_DATA_INDEX], BMP280_THREE_U8X +
+	bmp280_dev_data_len(p_dev, p_dev->oversamp_temperature),
+	BMP280_ZERO_U8X));
+	return com_rslt;
+}
+/*!
+ *	@brief This API decodes the result of a transaction
+ *	built by bmp280_txn_forced
+ *
+ *
+ *
+ *  @param txn : The completed transaction
+ *  @param v_uncomp_pressure_s32 : The uncompensated pressure
+ *  @param v_uncomp_temperature_s32 : The uncompensated temperature
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_txn_get_uncomp_pressure_temperature(
+const struct bmp280_txn_t *txn, s32 *v_uncomp_pressure_s32,
+s32 *v_uncomp_temperature_s32)
+{
+	if (txn == BMP280_NULL || v_uncomp_pressure_s32 == BMP280_NULL ||
+	v_uncomp_temperature_s32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	*v_uncomp_pressure_s32 = bmp280_decode_uncomp(
+	&txn->data[BMP280_TXN_FORCED_DATA_INDEX]);
+	*v_uncomp_temperature_s32 = bmp280_decode_uncomp(
+	&txn->data[BMP280_TXN_FORCED_DATA_INDEX + INDEX_THREE]);
+	return txn->com_rslt;
+}
+/*!
+ *	@brief This API queues a transaction on a bus
+ *	@note It may be called from any thread when the bus has a lock.
+ *
+ *
+ *
+ *  @param bus : The bus
+ *  @param txn : The transaction, it must not be touched until
+ *	its done callback has been called
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_bus_submit(struct bmp280_bus_t *bus,
+struct bmp280_txn_t *txn)
+{
+	if (bus == BMP280_NULL || txn == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	txn->step_index = BMP280_ZERO_U8X;
+	txn->com_rslt = SUCCESS;
+	txn->next = BMP280_NULL;
+	txn->submit_usec = bus->get_time_usec();
+	txn->ready_usec = txn->submit_usec;
+	if (bus->lock != BMP280_NULL)
+		bus->lock(bus->lock_context);
+	if (bus->tail != BMP280_NULL)
+		bus->tail->next = txn;
+	else
+		bus->head = txn;
+	bus->tail = txn;
+	bus->count++;
+	if (bus->unlock != BMP280_NULL)
+		bus->unlock(bus->lock_context);
+	return SUCCESS;
+}
+/* Runs the steps of txn up to its next wait or its end */
+static void bmp280_bus_burst(struct bmp280_bus_t *bus,
+struct bmp280_txn_t *txn)
+{
+	struct bmp280_xfer_t *step = BMP280_NULL;
+
+	while (txn->step_index < txn->step_count &&
+	txn->com_rslt == SUCCESS) {
+		step = &txn->step[txn->step_index++];
+		if (step->type == BMP280_XFER_WAIT) {
+			txn->ready_usec = bus->get_time_usec() +
+			step->wait_usec;
+			break;
+		} else if (step->type == BMP280_XFER_WRITE) {
+			txn->com_rslt = txn->dev->BMP280_BUS_WRITE_FUNC(
+			txn->dev->dev_addr, step->reg_addr,
+			step->data, step->len);
+		} else {
+			txn->com_rslt = txn->dev->BMP280_BUS_READ_FUNC(
+			txn->dev->dev_addr, step->reg_addr,
+			step->data, step->len);
+		}
+	}
+}
+/*!
+ *	@brief This API serves every transaction of the bus that is
+ *	ready, in submission order, and never blocks
+ *	@note Each ready transaction runs its steps up to its next wait,
+ *	then the bus moves on, so one pass is bounded by one burst per
+ *	queued transaction. Transactions of the same device run strictly
+ *	one after the other; one that ends with a wait completes once
+ *	the wait has passed. Only one thread may service a bus, and the
+ *	lock, if any, is never held during bus transfers or waits.
+ *
+ *
+ *
+ *  @param bus : The bus
+ *  @param v_next_usec_u32 : Time of the next ready transaction,
+ *	valid when bus->count is not zero
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_bus_service(struct bmp280_bus_t *bus,
+u32 *v_next_usec_u32)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = SUCCESS;
+	struct bmp280_txn_t *txn = BMP280_NULL;
+	struct bmp280_txn_t *prev = BMP280_NULL;
+	struct bmp280_txn_t *last = BMP280_NULL;
+	struct bmp280_txn_t *scan = BMP280_NULL;
+	u32 v_latency_usec_u32 = BMP280_ZERO_U8X;
+	u8 v_blocked_u8 = BMP280_ZERO_U8X;
+	u8 v_end_u8 = BMP280_ZERO_U8X;
+	u8 v_have_next_u8 = BMP280_ZERO_U8X;
+
+	if (bus == BMP280_NULL || v_next_usec_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	/* transactions submitted during this pass wait for the next one */
+	if (bus->lock != BMP280_NULL)
+		bus->lock(bus->lock_context);
+	txn = bus->head;
+	last = bus->tail;
+	if (bus->unlock != BMP280_NULL)
+		bus->unlock(bus->lock_context);
+	while (txn != BMP280_NULL && !v_end_u8) {
+		v_end_u8 = (txn == last);
+		v_blocked_u8 = BMP280_ZERO_U8X;
+		for (scan = bus->head; scan != txn; scan = scan->next)
+			if (scan->dev == txn->dev)
+				v_blocked_u8 = BMP280_ONE_U8X;
+		if (!v_blocked_u8 && BMP280_TIME_DIFF_USEC(txn->ready_usec,
+		bus->get_time_usec()) <= BMP280_ZERO_U8X)
+			bmp280_bus_burst(bus, txn);
+		/* a trailing wait has to pass before the transaction is
+		done, the device is busy until then */
+		if (txn->com_rslt == SUCCESS &&
+		(txn->step_index < txn->step_count ||
+		BMP280_TIME_DIFF_USEC(txn->ready_usec,
+		bus->get_time_usec()) > BMP280_ZERO_U8X)) {
+			if (!v_blocked_u8 && (!v_have_next_u8 ||
+			BMP280_TIME_DIFF_USEC(txn->ready_usec,
+			*v_next_usec_u32) < BMP280_ZERO_U8X)) {
+				*v_next_usec_u32 = txn->ready_usec;
+				v_have_next_u8 = BMP280_ONE_U8X;
+			}
+			prev = txn;
+			txn = txn->next;
+			continue;
+		}
+		/* done: unlink it under the lock, the tail may move */
+		if (bus->lock != BMP280_NULL)
+			bus->lock(bus->lock_context);
+		if (prev != BMP280_NULL)
+			prev->next = txn->next;
+		else
+			bus->head = txn->next;
+		if (bus->tail == txn)
+			bus->tail = prev;
+		bus->count--;
+		scan = txn->next;
+		if (bus->unlock != BMP280_NULL)
+			bus->unlock(bus->lock_context);
+		v_latency_usec_u32 = bus->get_time_usec() - txn->submit_usec;
+		if (v_latency_usec_u32 > bus->max_latency_usec)
+			bus->max_latency_usec = v_latency_usec_u32;
+		bus->txn_count++;
+		com_rslt = bmp280_first_error(com_rslt, txn->com_rslt);
+		if (txn->done != BMP280_NULL)
+			txn->done(txn);
+		txn = scan;
+	}
+	if (!v_have_next_u8)
+		*v_next_usec_u32 = bus->get_time_usec();
+	return com_rslt;
+}
+/* Bus utilization of one task, in ppm, from the bus and
+ * conversion time model; the task is not schedulable when
+ * its deadline window cannot hold the conversion and the transfers */
+static BMP280_RETURN_FUNCTION_TYPE bmp280_edf_density_ppm(
+const struct bmp280_edf_t *edf, const struct bmp280_edf_task_t *task,
+u32 *v_ppm_u32)
+{
+	u32 v_cost_usec_u32 = edf->xfer_usec;
+	u32 v_window_usec_u32 = task->latency_usec < task->period_usec ?
+	task->latency_usec : task->period_usec;
+	u32 v_meas_usec_u32 = BMP280_ZERO_U8X;
+
+	if (task->mode == BMP280_FORCED_MODE) {
+		/* trigger and read, the conversion runs off the bus */
+		v_cost_usec_u32 += edf->xfer_usec;
+		v_meas_usec_u32 = bmp280_meas_time_usec(
+		task->dev->oversamp_temperature,
+		task->dev->oversamp_pressure);
+	}
+	if (v_window_usec_u32 < v_meas_usec_u32 + v_cost_usec_u32 ||
+	v_cost_usec_u32 == BMP280_ZERO_U8X)
+		return E_BMP280_OUT_OF_RANGE;
+	v_window_usec_u32 -= v_meas_usec_u32;
+	*v_ppm_u32 = bmp280_mul_div_u32(v_cost_usec_u32,
+	BMP280_EDF_FULL_UTILIZATION_PPM, v_window_usec_u32 -
+	BMP280_ONE_U8X, v_window_usec_u32);
+	return SUCCESS;
+}
+/*!
+ *	@brief This API initializes an EDF scheduler for one bus
+ *
+ *
+ *
+ *  @param edf : The scheduler
+ *  @param a_task : Storage for v_capacity_u16 task pointers
+ *  @param v_capacity_u16 : Maximum number of sensors
+ *  @param v_xfer_usec_u32 : Bus model, time of one trigger
+ *	or data read transaction on this bus
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_edf_init(struct bmp280_edf_t *edf,
+struct bmp280_edf_task_t **a_task, u16 v_capacity_u16,
+u32 v_xfer_usec_u32)
+{
+	if (edf == BMP280_NULL || a_task == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	edf->task = a_task;
+	edf->count = BMP280_ZERO_U8X;
+	edf->capacity = v_capacity_u16;
+	edf->xfer_usec = v_xfer_usec_u32;
+	edf->utilization_ppm = BMP280_ZERO_U8X;
+	edf->job_count = BMP280_ZERO_U8X;
+	edf->miss_count = BMP280_ZERO_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API admits a sensor when the bus model can
+ *	sustain it together with the sensors already admitted
+ *	@note dev, period_usec, latency_usec, mode and sample_cb
+ *	have to be set before. A device in normal mode has to be
+ *	configured with a matching standby time by the caller.
+ *	@note A sensor is refused when its latency bound cannot hold
+ *	its conversion time plus its transfers, or when the summed
+ *	bus density of all sensors would exceed 100 %.
+ *
+ *
+ *
+ *  @param edf : The scheduler
+ *  @param task : The sensor
+ *  @param v_start_usec_u32 : Release of the first job
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Not schedulable or no free slot
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_edf_admit(struct bmp280_edf_t *edf,
+struct bmp280_edf_task_t *task, u32 v_start_usec_u32)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	u32 v_ppm_u32 = BMP280_ZERO_U8X;
+
+	if (edf == BMP280_NULL || task == BMP280_NULL ||
+	task->dev == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (edf->count >= edf->capacity)
+		return E_BMP280_OUT_OF_RANGE;
+	com_rslt = bmp280_edf_density_ppm(edf, task, &v_ppm_u32);
+	if (com_rslt != SUCCESS || edf->utilization_ppm + v_ppm_u32 >
+	BMP280_EDF_FULL_UTILIZATION_PPM)
+		return E_BMP280_OUT_OF_RANGE;
+	edf->utilization_ppm += v_ppm_u32;
+	task->density_ppm = v_ppm_u32;
+	task->state = BMP280_ASYNC_STATE_IDLE;
+	task->release_usec = v_start_usec_u32;
+	task->deadline_usec = v_start_usec_u32 + task->latency_usec;
+	task->seq = BMP280_ZERO_U8X;
+	task->miss_count = BMP280_ZERO_U8X;
+	task->max_response_usec = BMP280_ZERO_U8X;
+	edf->task[edf->count++] = task;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API removes a sensor and returns its bus share
+ *
+ *
+ *
+ *  @param edf : The scheduler
+ *  @param task : The sensor
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Sensor not admitted
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_edf_remove(struct bmp280_edf_t *edf,
+struct bmp280_edf_task_t *task)
+{
+	u16 v_index_u16 = BMP280_ZERO_U8X;
+
+	if (edf == BMP280_NULL || task == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	for (v_index_u16 = BMP280_ZERO_U8X; v_index_u16 < edf->count;
+	v_index_u16++) {
+		if (edf->task[v_index_u16] == task) {
+			edf->task[v_index_u16] = edf->task[--edf->count];
+			/* the settings may have changed since admission */
+			edf->utilization_ppm -= task->density_ppm;
+			return SUCCESS;
+		}
+	}
+	return E_BMP280_OUT_OF_RANGE;
+}
+/* Reads, compensates and delivers the current job of task */
+static BMP280_RETURN_FUNCTION_TYPE bmp280_edf_deliver(
+struct bmp280_edf_t *edf, struct bmp280_edf_task_t *task,
+u32 v_now_usec_u32)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	struct bmp280_sample_t sample;
+	u32 v_response_usec_u32 = v_now_usec_u32 - task->release_usec;
+
+	com_rslt = bmp280_dev_read_uncomp(task->dev,
+	&sample.uncomp_pressure, &sample.uncomp_temperature);
+	if (com_rslt == SUCCESS) {
+		bmp280_calib_compensate_memo(&task->dev->calib_param,
+		&task->dev->memo, sample.uncomp_temperature,
+		sample.uncomp_pressure, &sample.temperature,
+		&sample.pressure);
+		sample.timestamp_usec = task->mode == BMP280_FORCED_MODE ?
+		task->trigger_usec : v_now_usec_u32;
+		sample.status = BMP280_ZERO_U8X;
+		sample.seq = ++task->seq;
+		edf->job_count++;
+	}
+	if (v_response_usec_u32 > task->max_response_usec)
+		task->max_response_usec = v_response_usec_u32;
+	if (BMP280_TIME_DIFF_USEC(v_now_usec_u32, task->deadline_usec) >
+	BMP280_ZERO_U8X) {
+		task->miss_count++;
+		edf->miss_count++;
+	}
+	task->state = BMP280_ASYNC_STATE_IDLE;
+	task->release_usec += task->period_usec;
+	task->deadline_usec = task->release_usec + task->latency_usec;
+	if (task->sample_cb != BMP280_NULL)
+		task->sample_cb(task, com_rslt == SUCCESS ? &sample :
+		BMP280_NULL, com_rslt);
+	return com_rslt;
+}
+/*!
+ *	@brief This API runs every bus action that is due at
+ *	v_now_usec_u32 in earliest deadline first order and never blocks
+ *	@note A released job first triggers its forced conversion and
+ *	is read once the conversion time has passed; a job in normal
+ *	mode is read directly. When several actions are due, the one
+ *	whose job has the earliest deadline gets the bus first.
+ *	Deliveries after the deadline and jobs skipped because a whole
+ *	period was lost are counted as misses.
+ *
+ *
+ *
+ *  @param edf : The scheduler
+ *  @param v_now_usec_u32 : The current time in us
+ *  @param v_next_usec_u32 : Time of the next due action,
+ *	valid when edf->count is not zero
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_edf_run(struct bmp280_edf_t *edf,
+u32 v_now_usec_u32, u32 *v_next_usec_u32)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = SUCCESS;
+	BMP280_RETURN_FUNCTION_TYPE v_rslt_s8 = SUCCESS;
+	struct bmp280_edf_task_t *task = BMP280_NULL;
+	struct bmp280_edf_task_t *best = BMP280_NULL;
+	u32 v_due_usec_u32 = BMP280_ZERO_U8X;
+	u32 v_lost_u32 = BMP280_ZERO_U8X;
+	u16 v_index_u16 = BMP280_ZERO_U8X;
+
+	if (edf == BMP280_NULL || v_next_usec_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	do {
+		best = BMP280_NULL;
+		for (v_index_u16 = BMP280_ZERO_U8X; v_index_u16 < edf->count;
+		v_index_u16++) {
+			task = edf->task[v_index_u16];
+			v_due_usec_u32 = task->state ==
+			BMP280_ASYNC_STATE_IDLE ?
+			task->release_usec : task->ready_usec;
+			if (BMP280_TIME_DIFF_USEC(v_now_usec_u32,
+			v_due_usec_u32) >= BMP280_ZERO_U8X &&
+			(best == BMP280_NULL ||
+			BMP280_TIME_DIFF_USEC(task->deadline_usec,
+			best->deadline_usec) < BMP280_ZERO_U8X))
+				best = task;
+		}
+		if (best == BMP280_NULL)
+			break;
+		if (best->state == BMP280_ASYNC_STATE_CONVERTING) {
+			com_rslt = bmp280_first_error(com_rslt,
+			bmp280_edf_deliver(edf, best, v_now_usec_u32));
+			continue;
+		}
+		/* jobs whose whole period already passed are skipped */
+		v_lost_u32 = (v_now_usec_u32 - best->release_usec) /
+		best->period_usec;
+		if (v_lost_u32 > BMP280_ZERO_U8X) {
+			best->miss_count += v_lost_u32;
+			edf->miss_count += v_lost_u32;
+			best->release_usec += v_lost_u32 * best->period_usec;
+			best->deadline_usec = best->release_usec +
+			best->latency_usec;
+		}
+		if (best->mode != BMP280_FORCED_MODE) {
+			com_rslt = bmp280_first_error(com_rslt,
+			bmp280_edf_deliver(edf, best, v_now_usec_u32));
+			continue;
+		}
+		v_rslt_s8 = bmp280_dev_trigger_forced(best->dev);
+		if (v_rslt_s8 == SUCCESS) {
+			best->state = BMP280_ASYNC_STATE_CONVERTING;
+			best->trigger_usec = v_now_usec_u32;
+			best->ready_usec = v_now_usec_u32 +
+			bmp280_meas_time_usec(best->dev->oversamp_temperature,
+			best->dev->oversamp_pressure);
+		} else {
+			/* the job is lost, retry with the next release */
+			best->miss_count++;
+			edf->miss_count++;
+			best->release_usec += best->period_usec;
+			best->deadline_usec = best->release_usec +
+			best->latency_usec;
+			if (best->sample_cb != BMP280_NULL)
+				best->sample_cb(best, BMP280_NULL, v_rslt_s8);
+		}
+		com_rslt = bmp280_first_error(com_rslt, v_rslt_s8);
+	} while (best != BMP280_NULL);
+	*v_next_usec_u32 = v_now_usec_u32;
+	for (v_index_u16 = BMP280_ZERO_U8X; v_index_u16 < edf->count;
+	v_index_u16++) {
+		task = edf->task[v_index_u16];
+		v_due_usec_u32 = task->state == BMP280_ASYNC_STATE_IDLE ?
+		task->release_usec : task->ready_usec;
+		if (v_index_u16 == BMP280_ZERO_U8X ||
+		BMP280_TIME_DIFF_USEC(v_due_usec_u32, *v_next_usec_u32) <
+		BMP280_ZERO_U8X)
+			*v_next_usec_u32 = v_due_usec_u32;
+	}
+	return com_rslt;
+}
+/*!
+ *	@brief This API adds one sample taken on a fixed time grid
+ *	to the jitter statistics
+ *
+ *
+ *
+ *  @param jitter_stat : The statistics
+ *  @param v_planned_usec_u32 : Grid time of the sample
+ *  @param v_actual_usec_u32 : Time the sample was actually triggered
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_jitter_update(
+struct bmp280_jitter_stat_t *jitter_stat, u32 v_planned_usec_u32,
+u32 v_actual_usec_u32)
+{
+	s32 v_jitter_s32 = BMP280_TIME_DIFF_USEC(v_actual_usec_u32,
+	v_planned_usec_u32);
+
+	if (jitter_stat == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (jitter_stat->count == BMP280_ZERO_U8X ||
+	v_jitter_s32 < jitter_stat->min_jitter_usec)
+		jitter_stat->min_jitter_usec = v_jitter_s32;
+	if (jitter_stat->count == BMP280_ZERO_U8X ||
+	v_jitter_s32 > jitter_stat->max_jitter_usec)
+		jitter_stat->max_jitter_usec = v_jitter_s32;
+	jitter_stat->last_jitter_usec = v_jitter_s32;
+	jitter_stat->count++;
+	jitter_stat->mean_jitter_usec = bmp280_mean_update(
+	jitter_stat->mean_jitter_usec, &jitter_stat->rem_jitter_usec,
+	v_jitter_s32, jitter_stat->count);
+	return SUCCESS;
+}
+/*!
+ *	@brief This API initializes the pressure-only read path
+ *
+ *
+ *
+ *  @param fast : The read path state
+ *  @param v_max_interval_u16 : Samples per temperature refresh
+ *	at most, 1 reads the temperature every time
+ *  @param v_drift_bound_s32 : t_fine change between two refreshes
+ *	that shortens the interval (5120 t_fine is about 1 DegC)
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Interval is zero
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_fast_read_init(
+struct bmp280_fast_read_t *fast, u16 v_max_interval_u16,
+s32 v_drift_bound_s32)
+{
+	if (fast == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_max_interval_u16 == BMP280_ZERO_U8X)
+		return E_BMP280_OUT_OF_RANGE;
+	fast->max_interval = v_max_interval_u16;
+	fast->interval = v_max_interval_u16;
+	fast->countdown = BMP280_ZERO_U8X;
+	fast->valid = BMP280_ZERO_U8X;
+	fast->drift_bound = v_drift_bound_s32;
+	fast->t_fine = BMP280_ZERO_U8X;
+	fast->temperature = BMP280_ZERO_U8X;
+	fast->temperature_read_count = BMP280_ZERO_U8X;
+	fast->pressure_only_count = BMP280_ZERO_U8X;
+	return SUCCESS;
+}
+/* Adapts the refresh interval to the t_fine drift since the last
+ * refresh: halved above the drift bound, doubled below half of it */
+static void bmp280_fast_read_adapt(struct bmp280_fast_read_t *fast,
+s32 v_t_fine_s32)
+{
+	s32 v_drift_s32 = v_t_fine_s32 - fast->t_fine;
+
+	if (v_drift_s32 < BMP280_ZERO_U8X)
+		v_drift_s32 = -v_drift_s32;
+	if (v_drift_s32 > fast->drift_bound &&
+	fast->interval > BMP280_ONE_U8X)
+		fast->interval >>= SHIFT_RIGHT_1_POSITION;
+	else if (v_drift_s32 <= (fast->drift_bound >>
+	SHIFT_RIGHT_1_POSITION) && fast->interval < fast->max_interval)
+		fast->interval = (fast->interval <=
+		(fast->max_interval >> SHIFT_RIGHT_1_POSITION)) ?
+		(u16)(fast->interval << SHIFT_LEFT_1_POSITION) :
+		fast->max_interval;
+}
+/*!
+ *	@brief This API reads the true pressure and temperature, but
+ *	reads only the three pressure bytes 0xF7 to 0xF9 on most calls
+ *	and compensates them with the cached t_fine
+ *	@note Temperature and t_fine are refreshed with a full six byte
+ *	read every interval samples; the returned temperature is the
+ *	one of the last refresh.
+ *	A failed refresh keeps temperature, t_fine and the interval
+ *	and is retried on the next call.
+ *
+ *
+ *
+ *  @param fast : The read path state
+ *  @param v_pressure_u32 : The value of compensated pressure
+ *  @param v_temperature_s32 : The value of compensated temperature
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_fast_read_pressure_temperature(
+struct bmp280_fast_read_t *fast, u32 *v_pressure_u32,
+s32 *v_temperature_s32)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	s32 v_uncomp_pressure_s32 = BMP280_ZERO_U8X;
+	s32 v_uncomp_temperature_s32 = BMP280_ZERO_U8X;
+
+	if (p_bmp280 == BMP280_NULL || fast == BMP280_NULL ||
+	v_pressure_u32 == BMP280_NULL || v_temperature_s32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (fast->valid && fast->countdown > BMP280_ZERO_U8X) {
+		com_rslt = bmp280_read_uncomp_pressure(&v_uncomp_pressure_s32);
+		fast->countdown--;
+		fast->pressure_only_count++;
+		p_bmp280->calib_param.t_fine = fast->t_fine;
+		/* the memo holds the coefficients of this t_fine unless
+		another read path updated it since the refresh */
+		if (p_bmp280->memo.valid &&
+		p_bmp280->memo.t_fine == fast->t_fine)
+			*v_pressure_u32 = bmp280_calib_P_apply(
+			&p_bmp280->calib_param, p_bmp280->memo.p_divisor,
+			p_bmp280->memo.p_offset, v_uncomp_pressure_s32);
+		else
+			*v_pressure_u32 = bmp280_compensate_P_int32(
+			v_uncomp_pressure_s32);
+	} else {
+		com_rslt = bmp280_read_uncomp_pressure_temperature(
+		&v_uncomp_pressure_s32, &v_uncomp_temperature_s32);
+		fast->temperature_read_count++;
+		/* a failed read must not touch the cache nor move the
+		interval; the next call retries the full read */
+		if (com_rslt != SUCCESS) {
+			fast->valid = BMP280_ZERO_U8X;
+		} else {
+			bmp280_calib_compensate_memo(&p_bmp280->calib_param,
+			&p_bmp280->memo, v_uncomp_temperature_s32,
+			v_uncomp_pressure_s32, &fast->temperature,
+			v_pressure_u32);
+			if (fast->valid)
+				bmp280_fast_read_adapt(fast,
+				p_bmp280->calib_param.t_fine);
+			fast->t_fine = p_bmp280->calib_param.t_fine;
+			fast->countdown = fast->interval - BMP280_ONE_U8X;
+			fast->valid = BMP280_ONE_U8X;
+		}
+	}
+	*v_temperature_s32 = fast->temperature;
+	return com_rslt;
+}
+/*!
+ *	@brief This API maps a pressure back to the raw ADC code
+ *	for a given t_fine, so that pressure thresholds can be
+ *	checked on raw samples without compensating them
+ *	@note The result is the largest raw code whose pressure is at
+ *	least v_pressure_u32. As the compensated pressure falls with the
+ *	raw code, a raw sample above the result is below the pressure
+ *	and any other raw sample is at or above it. The result is -1
+ *	when no code reaches the pressure.
+ *
+ *
+ *
+ *  @param calib : Calibration data of the device
+ *  @param v_t_fine_s32 : The fine temperature the bound is valid for
+ *  @param v_pressure_u32 : The pressure in Pa
+ *  @param v_uncomp_pressure_s32 : The raw pressure code
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_invert_pressure(
+const struct bmp280_calib_param_t *calib, s32 v_t_fine_s32,
+u32 v_pressure_u32, s32 *v_uncomp_pressure_s32)
+{
+	s32 v_divisor_s32 = BMP280_ZERO_U8X;
+	s32 v_offset_s32 = BMP280_ZERO_U8X;
+	s32 v_low_s32 = -BMP280_ONE_U8X;
+	s32 v_high_s32 = BMP280_UNCOMP_CODE_COUNT - BMP280_ONE_U8X;
+	s32 v_mid_s32 = BMP280_ZERO_U8X;
+
+	if (calib == BMP280_NULL || v_uncomp_pressure_s32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	bmp280_calib_P_coeff(calib, v_t_fine_s32, &v_divisor_s32,
+	&v_offset_s32);
+	/* codes above 2^20 - offset wrap around and are not monotonic */
+	if (v_offset_s32 > BMP280_ZERO_U8X)
+		v_high_s32 -= v_offset_s32;
+	/* invariant: P(low) >= target (low = -1 stands for none),
+	P(code) < target for every code above high */
+	if (bmp280_calib_P_apply(calib, v_divisor_s32, v_offset_s32,
+	v_high_s32) >= v_pressure_u32)
+		v_low_s32 = v_high_s32;
+	while (v_low_s32 < v_high_s32) {
+		v_mid_s32 = v_low_s32 + ((v_high_s32 - v_low_s32 +
+		BMP280_ONE_U8X) >> SHIFT_RIGHT_1_POSITION);
+		if (bmp280_calib_P_apply(calib, v_divisor_s32, v_offset_s32,
+		v_mid_s32) >= v_pressure_u32)
+			v_low_s32 = v_mid_s32;
+		else
+			v_high_s32 = v_mid_s32 - BMP280_ONE_U8X;
+	}
+	*v_uncomp_pressure_s32 = v_low_s32;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API maps a temperature back to the raw ADC code
+ *	@note The result is the smallest raw code whose temperature is
+ *	at least v_temperature_s32. As the compensated temperature rises
+ *	with the raw code, a raw sample at or above the result is at or
+ *	above the temperature. The result is BMP280_UNCOMP_CODE_COUNT
+ *	when no code reaches the temperature.
+ *
+ *
+ *
+ *  @param calib : Calibration data of the device
+ *  @param v_temperature_s32 : The temperature in 0.01 DegC
+ *  @param v_uncomp_temperature_s32 : The raw temperature code
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_invert_temperature(
+const struct bmp280_calib_param_t *calib, s32 v_temperature_s32,
+s32 *v_uncomp_temperature_s32)
+{
+	/* t_fine of the search lives in this private copy */
+	struct bmp280_calib_param_t calib_local;
+	s32 v_low_s32 = BMP280_ZERO_U8X;
+	s32 v_high_s32 = BMP280_UNCOMP_CODE_COUNT;
+	s32 v_mid_s32 = BMP280_ZERO_U8X;
+
+	if (calib == BMP280_NULL || v_uncomp_temperature_s32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	calib_local = *calib;
+	/* invariant: T(code) < target below low, T(high) >= target
+	(high = BMP280_UNCOMP_CODE_COUNT stands for none) */
+	while (v_low_s32 < v_high_s32) {
+		v_mid_s32 = v_low_s32 + ((v_high_s32 - v_low_s32) >>
+		SHIFT_RIGHT_1_POSITION);
+		if (bmp280_calib_compensate_T_int32(&calib_local, v_mid_s32)
+		>= v_temperature_s32)
+			v_high_s32 = v_mid_s32;
+		else
+			v_low_s32 = v_mid_s32 + BMP280_ONE_U8X;
+	}
+	*v_uncomp_temperature_s32 = v_low_s32;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API sets up a raw domain trigger
+ *	@note A level trigger starts armed, so it fires on the first
+ *	sample that is already beyond its level.
+ *
+ *
+ *
+ *  @param trigger : The trigger
+ *  @param v_type_u8 : BMP280_TRIGGER_ABOVE, _BELOW or _RATE
+ *  @param v_channel_u8 : BMP280_CHANNEL_PRESSURE or _TEMPERATURE
+ *  @param v_level_s32 : Level in Pa or 0.01 DegC
+ *  @param v_hysteresis_s32 : Distance from the level that re-arms
+ *	a level trigger
+ *  @param v_rate_u32 : Rate in Pa or 0.01 DegC per second
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Unknown type or channel
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_trigger_init(
+struct bmp280_trigger_t *trigger, u8 v_type_u8, u8 v_channel_u8,
+s32 v_level_s32, s32 v_hysteresis_s32, u32 v_rate_u32)
+{
+	if (trigger == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_type_u8 > BMP280_TRIGGER_RATE ||
+	v_channel_u8 > BMP280_CHANNEL_TEMPERATURE || v_hysteresis_s32 < 0)
+		return E_BMP280_OUT_OF_RANGE;
+	trigger->type = v_type_u8;
+	trigger->channel = v_channel_u8;
+	trigger->armed = BMP280_ONE_U8X;
+	trigger->fired = BMP280_ZERO_U8X;
+	trigger->level = v_level_s32;
+	trigger->hysteresis = v_hysteresis_s32;
+	trigger->rate = v_rate_u32;
+	trigger->compiled = BMP280_ZERO_U8X;
+	trigger->has_last = BMP280_ZERO_U8X;
+	trigger->fire_count = BMP280_ZERO_U8X;
+	trigger->compile_count = BMP280_ZERO_U8X;
+	return SUCCESS;
+}
+/* Smallest raw key whose physical value is at least v_value_s32 */
+static s32 bmp280_trigger_key(const struct bmp280_calib_param_t *calib,
+u8 v_channel_u8, s32 v_t_fine_s32, s32 v_value_s32)
+{
+	s32 v_raw_s32 = BMP280_ZERO_U8X;
+
+	if (v_channel_u8 == BMP280_CHANNEL_TEMPERATURE) {
+		bmp280_invert_temperature(calib, v_value_s32, &v_raw_s32);
+		return v_raw_s32;
+	}
+	if (v_value_s32 < BMP280_ZERO_U8X)
+		v_value_s32 = BMP280_ZERO_U8X;
+	bmp280_invert_pressure(calib, v_t_fine_s32, (u32)v_value_s32,
+	&v_raw_s32);
+	return -v_raw_s32;
+}
+/* Raw codes that correspond to a change of v_value_u32 (Pa or 0.01 DegC)
+ * of a channel, from the slope at the operating point of the sample */
+static u32 bmp280_channel_raw_delta(const struct bmp280_calib_param_t *calib,
+u8 v_channel_u8, const struct bmp280_sample_t *sample, u32 v_value_u32)
+{
+	struct bmp280_calib_param_t calib_local = *calib;
+	s32 v_divisor_s32 = BMP280_ZERO_U8X;
+	s32 v_offset_s32 = BMP280_ZERO_U8X;
+	s32 v_raw_s32 = BMP280_ZERO_U8X;
+	s32 v_span_s32 = BMP280_ZERO_U8X;
+
+	bmp280_calib_compensate_T_int32(&calib_local,
+	sample->uncomp_temperature);
+	/* value change over BMP280_TRIGGER_SLOPE_SPAN codes */
+	if (v_channel_u8 == BMP280_CHANNEL_TEMPERATURE) {
+		v_raw_s32 = sample->uncomp_temperature;
+		v_span_s32 = bmp280_calib_compensate_T_int32(&calib_local,
+		v_raw_s32 + BMP280_TRIGGER_SLOPE_SPAN) -
+		bmp280_calib_compensate_T_int32(&calib_local, v_raw_s32);
+	} else {
+		v_raw_s32 = sample->uncomp_pressure;
+		bmp280_calib_P_coeff(calib, calib_local.t_fine,
+		&v_divisor_s32, &v_offset_s32);
+		v_span_s32 = (s32)(bmp280_calib_P_apply(calib, v_divisor_s32,
+		v_offset_s32, v_raw_s32) - bmp280_calib_P_apply(calib,
+		v_divisor_s32, v_offset_s32,
+		v_raw_s32 + BMP280_TRIGGER_SLOPE_SPAN));
+	}
+	if (v_span_s32 < BMP280_ONE_U8X)
+		v_span_s32 = BMP280_ONE_U8X;
+	return bmp280_mul_div_u32(v_value_u32, BMP280_TRIGGER_SLOPE_SPAN,
+	BMP280_ZERO_U8X, (u32)v_span_s32);
+}
+/* Compiles the physical bounds of trigger into raw keys around
+ * the operating point of the given sample */
+static void bmp280_trigger_compile(const struct bmp280_calib_param_t *calib,
+struct bmp280_trigger_t *trigger, const struct bmp280_sample_t *sample)
+{
+	struct bmp280_calib_param_t calib_local = *calib;
+
+	bmp280_calib_compensate_T_int32(&calib_local,
+	sample->uncomp_temperature);
+	switch (trigger->type) {
+	case BMP280_TRIGGER_ABOVE:
+		trigger->key_fire = bmp280_trigger_key(calib, trigger->channel,
+		calib_local.t_fine, trigger->level + BMP280_ONE_U8X);
+		trigger->key_rearm = bmp280_trigger_key(calib,
+		trigger->channel, calib_local.t_fine,
+		trigger->level - trigger->hysteresis);
+		break;
+	case BMP280_TRIGGER_BELOW:
+		trigger->key_fire = bmp280_trigger_key(calib, trigger->channel,
+		calib_local.t_fine, trigger->level);
+		trigger->key_rearm = bmp280_trigger_key(calib,
+		trigger->channel, calib_local.t_fine,
+		trigger->level + trigger->hysteresis + BMP280_ONE_U8X);
+		break;
+	default:
+		trigger->raw_rate = bmp280_channel_raw_delta(calib,
+		trigger->channel, sample, trigger->rate);
+		break;
+	}
+	trigger->compiled_uncomp_temperature = sample->uncomp_temperature;
+	trigger->compiled = BMP280_ONE_U8X;
+	trigger->compile_count++;
+}
+/*!
+ *	@brief This API evaluates triggers on one raw sample with
+ *	integer compares only
+ *	@note A trigger is compiled again when the raw temperature
+ *	moved by more than v_tolerance_s32 codes since its last
+ *	compilation. Only samples that fire need to be compensated.
+ *
+ *
+ *
+ *  @param calib : Calibration data of the device
+ *  @param a_trigger : The triggers
+ *  @param v_count_u16 : Number of triggers
+ *  @param v_tolerance_s32 : Raw temperature change that
+ *	recompiles a trigger
+ *  @param sample : The sample, only its raw fields and its
+ *	timestamp are used
+ *  @param v_fired_u16 : Number of triggers that fired, each of
+ *	them has its fired flag set
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_trigger_eval(
+const struct bmp280_calib_param_t *calib,
+struct bmp280_trigger_t *a_trigger, u16 v_count_u16,
+s32 v_tolerance_s32, const struct bmp280_sample_t *sample,
+u16 *v_fired_u16)
+{
+	struct bmp280_trigger_t *trigger = BMP280_NULL;
+	s32 v_key_s32 = BMP280_ZERO_U8X;
+	s32 v_drift_s32 = BMP280_ZERO_U8X;
+	u32 v_delta_u32 = BMP280_ZERO_U8X;
+	u16 v_index_u16 = BMP280_ZERO_U8X;
+
+	if (calib == BMP280_NULL || a_trigger == BMP280_NULL ||
+	sample == BMP280_NULL || v_fired_u16 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	*v_fired_u16 = BMP280_ZERO_U8X;
+	for (v_index_u16 = BMP280_ZERO_U8X; v_index_u16 < v_count_u16;
+	v_index_u16++) {
+		trigger = &a_trigger[v_index_u16];
+		trigger->fired = BMP280_ZERO_U8X;
+		v_drift_s32 = sample->uncomp_temperature -
+		trigger->compiled_uncomp_temperature;
+		if (!trigger->compiled || v_drift_s32 > v_tolerance_s32 ||
+		v_drift_s32 < -v_tolerance_s32)
+			bmp280_trigger_compile(calib, trigger, sample);
+		v_key_s32 = trigger->channel == BMP280_CHANNEL_TEMPERATURE ?
+		sample->uncomp_temperature : -sample->uncomp_pressure;
+		if (trigger->type == BMP280_TRIGGER_ABOVE) {
+			if (trigger->armed && v_key_s32 >= trigger->key_fire)
+				trigger->fired = BMP280_ONE_U8X;
+			else if (!trigger->armed &&
+			v_key_s32 < trigger->key_rearm)
+				trigger->armed = BMP280_ONE_U8X;
+		} else if (trigger->type == BMP280_TRIGGER_BELOW) {
+			if (trigger->armed && v_key_s32 < trigger->key_fire)
+				trigger->fired = BMP280_ONE_U8X;
+			else if (!trigger->armed &&
+			v_key_s32 >= trigger->key_rearm)
+				trigger->armed = BMP280_ONE_U8X;
+		} else if (trigger->has_last) {
+			v_delta_u32 = (u32)(v_key_s32 > trigger->last_key ?
+			v_key_s32 - trigger->last_key :
+			trigger->last_key - v_key_s32);
+			/* delta * 1e6 > rate * dt, exact in 32 bits */
+			if (v_delta_u32 > bmp280_mul_div_u32(
+			trigger->raw_rate, sample->timestamp_usec -
+			trigger->last_usec, BMP280_ZERO_U8X,
+			BMP280_USEC_PER_SEC))
+				trigger->fired = BMP280_ONE_U8X;
+		}
+		trigger->last_key = v_key_s32;
+		trigger->last_usec = sample->timestamp_usec;
+		trigger->has_last = BMP280_ONE_U8X;
+		if (trigger->fired) {
+			if (trigger->type != BMP280_TRIGGER_RATE)
+				trigger->armed = BMP280_ZERO_U8X;
+			trigger->fire_count++;
+			(*v_fired_u16)++;
+		}
+	}
+	return SUCCESS;
+}
+/*!
+ *	@brief This API sets up a delta-publish stage
+ *
+ *
+ *
+ *  @param publish : The publish stage
+ *  @param v_deadband_pressure_u32 : Pressure change in Pa that is
+ *	published, 0 publishes every change
+ *  @param v_deadband_temperature_u32 : Temperature change in
+ *	0.01 DegC that is published, 0 publishes every change
+ *  @param v_max_silence_usec_u32 : Longest time without a published
+ *	sample, 0 for no limit
+ *  @param v_heartbeat_usec_u32 : Longest time without any message,
+ *	0 for no heartbeat
+ *  @param v_tolerance_s32 : Raw temperature change that
+ *	recompiles the deadbands
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_publish_init(
+struct bmp280_publish_t *publish, u32 v_deadband_pressure_u32,
+u32 v_deadband_temperature_u32, u32 v_max_silence_usec_u32,
+u32 v_heartbeat_usec_u32, s32 v_tolerance_s32)
+{
+	if (publish == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	publish->deadband_pressure = v_deadband_pressure_u32;
+	publish->deadband_temperature = v_deadband_temperature_u32;
+	publish->max_silence_usec = v_max_silence_usec_u32;
+	publish->heartbeat_usec = v_heartbeat_usec_u32;
+	publish->tolerance = v_tolerance_s32;
+	publish->compiled = BMP280_ZERO_U8X;
+	publish->has_last = BMP280_ZERO_U8X;
+	publish->sample_count = BMP280_ZERO_U8X;
+	publish->publish_count = BMP280_ZERO_U8X;
+	publish->heartbeat_count = BMP280_ZERO_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API decides from the raw fields of a sample
+ *	whether it has to be published
+ *	@note A sample is published when pressure or temperature moved
+ *	beyond its deadband since the last published sample, or when
+ *	max_silence_usec passed without one. Otherwise a heartbeat is
+ *	due when heartbeat_usec passed without any message. Only
+ *	published samples need to be compensated.
+ *
+ *
+ *
+ *  @param calib : Calibration data of the device
+ *  @param publish : The publish stage
+ *  @param sample : The sample, only its raw fields and its
+ *	timestamp are used
+ *  @param v_action_u8 : BMP280_PUBLISH_NONE, BMP280_PUBLISH_SAMPLE
+ *	or BMP280_PUBLISH_HEARTBEAT
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_publish_eval(
+const struct bmp280_calib_param_t *calib,
+struct bmp280_publish_t *publish, const struct bmp280_sample_t *sample,
+u8 *v_action_u8)
+{
+	s32 v_drift_s32 = BMP280_ZERO_U8X;
+	s32 v_delta_p_s32 = BMP280_ZERO_U8X;
+	s32 v_delta_t_s32 = BMP280_ZERO_U8X;
+
+	if (calib == BMP280_NULL || publish == BMP280_NULL ||
+	sample == BMP280_NULL || v_action_u8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	publish->sample_count++;
+	*v_action_u8 = BMP280_PUBLISH_NONE;
+	v_drift_s32 = sample->uncomp_temperature -
+	publish->compiled_uncomp_temperature;
+	if (!publish->compiled || v_drift_s32 > publish->tolerance ||
+	v_drift_s32 < -publish->tolerance) {
+		publish->raw_deadband_pressure = bmp280_channel_raw_delta(
+		calib, BMP280_CHANNEL_PRESSURE, sample,
+		publish->deadband_pressure);
+		publish->raw_deadband_temperature = bmp280_channel_raw_delta(
+		calib, BMP280_CHANNEL_TEMPERATURE, sample,
+		publish->deadband_temperature);
+		publish->compiled_uncomp_temperature =
+		sample->uncomp_temperature;
+		publish->compiled = BMP280_ONE_U8X;
+	}
+	if (!publish->has_last) {
+		*v_action_u8 = BMP280_PUBLISH_SAMPLE;
+	} else {
+		v_delta_p_s32 = sample->uncomp_pressure -
+		publish->last_uncomp_pressure;
+		v_delta_t_s32 = sample->uncomp_temperature -
+		publish->last_uncomp_temperature;
+		if (v_delta_p_s32 < BMP280_ZERO_U8X)
+			v_delta_p_s32 = -v_delta_p_s32;
+		if (v_delta_t_s32 < BMP280_ZERO_U8X)
+			v_delta_t_s32 = -v_delta_t_s32;
+		if ((u32)v_delta_p_s32 > publish->raw_deadband_pressure ||
+		(u32)v_delta_t_s32 > publish->raw_deadband_temperature ||
+		(publish->max_silence_usec != BMP280_ZERO_U8X &&
+		sample->timestamp_usec - publish->last_publish_usec >=
+		publish->max_silence_usec))
+			*v_action_u8 = BMP280_PUBLISH_SAMPLE;
+		else if (publish->heartbeat_usec != BMP280_ZERO_U8X &&
+		sample->timestamp_usec - publish->last_message_usec >=
+		publish->heartbeat_usec)
+			*v_action_u8 = BMP280_PUBLISH_HEARTBEAT;
+	}
+	if (*v_action_u8 == BMP280_PUBLISH_SAMPLE) {
+		publish->last_uncomp_pressure = sample->uncomp_pressure;
+		publish->last_uncomp_temperature = sample->uncomp_temperature;
+		publish->last_publish_usec = sample->timestamp_usec;
+		publish->has_last = BMP280_ONE_U8X;
+		publish->publish_count++;
+	} else if (*v_action_u8 == BMP280_PUBLISH_HEARTBEAT) {
+		publish->heartbeat_count++;
+	}
+	if (*v_action_u8 != BMP280_PUBLISH_NONE)
+		publish->last_message_usec = sample->timestamp_usec;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API sets up a software IIR filter stage with the
+ *	coefficients of the on-chip filter
+ *	@note The first sample primes the filter and passes unchanged.
+ *
+ *
+ *
+ *  @param iir : The filter stage
+ *  @param v_coeff_u8 : The filter coefficient
+ *  value             |  coefficient
+ * -------------------|------------------------
+ *	0x00        | BMP280_FILTER_COEFF_OFF
+ *	0x01        | BMP280_FILTER_COEFF_2
+ *	0x02        | BMP280_FILTER_COEFF_4
+ *	0x03        | BMP280_FILTER_COEFF_8
+ *	0x04        | BMP280_FILTER_COEFF_16
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Unknown coefficient
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_iir_init(struct bmp280_iir_t *iir,
+u8 v_coeff_u8)
+{
+	if (iir == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_coeff_u8 > BMP280_FILTER_COEFF_16)
+		return E_BMP280_OUT_OF_RANGE;
+	iir->coeff = v_coeff_u8;
+	iir->primed = BMP280_ZERO_U8X;
+	iir->pressure = BMP280_ZERO_U8X;
+	iir->temperature = BMP280_ZERO_U8X;
+	iir->pressure_state = BMP280_ZERO_U8X;
+	iir->temperature_state = BMP280_ZERO_U8X;
+	return SUCCESS;
+}
+/* One filter step on a state with BMP280_IIR_FRAC_BITS fractional
+ * bits, the coefficient is 2^v_shift_u8. The increment is rounded,
+ * so the state settles within half a fractional step of the input. */
+static s32 bmp280_iir_step(s32 v_state_s32, s32 v_input_s32, u8 v_shift_u8)
+{
+	s32 v_diff_s32 = (v_input_s32 << BMP280_IIR_FRAC_BITS) - v_state_s32;
+
+	if (v_shift_u8 == BMP280_ZERO_U8X)
+		return v_state_s32 + v_diff_s32;
+	return v_state_s32 + ((v_diff_s32 +
+	(BMP280_ONE_U8X << (v_shift_u8 - BMP280_ONE_U8X))) >> v_shift_u8);
+}
+/* Raw code of a filter state, rounded */
+static s32 bmp280_iir_output(s32 v_state_s32)
+{
+	return (v_state_s32 + (BMP280_ONE_U8X <<
+	(BMP280_IIR_FRAC_BITS - BMP280_ONE_U8X))) >> BMP280_IIR_FRAC_BITS;
+}
+/*!
+ *	@brief This API filters the raw fields of one sample in place
+ *
+ *
+ *
+ *  @param iir : The filter stage
+ *  @param sample : The sample, uncomp_pressure and
+ *	uncomp_temperature are replaced by their filtered values
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_iir_apply(struct bmp280_iir_t *iir,
+struct bmp280_sample_t *sample)
+{
+	if (iir == BMP280_NULL || sample == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (iir->primed) {
+		iir->pressure_state = bmp280_iir_step(iir->pressure_state,
+		sample->uncomp_pressure, iir->coeff);
+		iir->temperature_state = bmp280_iir_step(
+		iir->temperature_state, sample->uncomp_temperature,
+		iir->coeff);
+	} else {
+		iir->pressure_state = sample->uncomp_pressure <<
+		BMP280_IIR_FRAC_BITS;
+		iir->temperature_state = sample->uncomp_temperature <<
+		BMP280_IIR_FRAC_BITS;
+		iir->primed = BMP280_ONE_U8X;
+	}
+	iir->pressure = bmp280_iir_output(iir->pressure_state);
+	iir->temperature = bmp280_iir_output(iir->temperature_state);
+	sample->uncomp_pressure = iir->pressure;
+	sample->uncomp_temperature = iir->temperature;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API filters arrays of raw codes in place, e.g.
+ *	to replay a log with a different smoothing
+ *	@note Each channel runs over its own contiguous array with the
+ *	state held in a local, so the loop carries no memory dependency
+ *	besides the recurrence itself. Either array may be BMP280_NULL.
+ *
+ *
+ *
+ *  @param iir : The filter stage
+ *  @param a_uncomp_pressure_s32 : Raw pressure codes
+ *  @param a_uncomp_temperature_s32 : Raw temperature codes
+ *  @param v_count_u32 : Number of codes per array
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_iir_batch(struct bmp280_iir_t *iir,
+s32 *a_uncomp_pressure_s32, s32 *a_uncomp_temperature_s32,
+u32 v_count_u32)
+{
+	s32 v_state_s32 = BMP280_ZERO_U8X;
+	u32 v_index_u32 = BMP280_ZERO_U8X;
+	u8 v_shift_u8 = BMP280_ZERO_U8X;
+
+	if (iir == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_count_u32 == BMP280_ZERO_U8X)
+		return SUCCESS;
+	v_shift_u8 = iir->coeff;
+	if (!iir->primed) {
+		/* the first codes prime the filter */
+		if (a_uncomp_pressure_s32 != BMP280_NULL)
+			iir->pressure_state = a_uncomp_pressure_s32[INDEX_ZERO]
+			<< BMP280_IIR_FRAC_BITS;
+		if (a_uncomp_temperature_s32 != BMP280_NULL)
+			iir->temperature_state =
+			a_uncomp_temperature_s32[INDEX_ZERO] <<
+			BMP280_IIR_FRAC_BITS;
+		iir->primed = BMP280_ONE_U8X;
+	}
+	if (a_uncomp_pressure_s32 != BMP280_NULL) {
+		v_state_s32 = iir->pressure_state;
+		for (v_index_u32 = BMP280_ZERO_U8X; v_index_u32 < v_count_u32;
+		v_index_u32++) {
+			v_state_s32 = bmp280_iir_step(v_state_s32,
+			a_uncomp_pressure_s32[v_index_u32], v_shift_u8);
+			a_uncomp_pressure_s32[v_index_u32] =
+			bmp280_iir_output(v_state_s32);
+		}
+		iir->pressure_state = v_state_s32;
+		iir->pressure = bmp280_iir_output(v_state_s32);
+	}
+	if (a_uncomp_temperature_s32 != BMP280_NULL) {
+		v_state_s32 = iir->temperature_state;
+		for (v_index_u32 = BMP280_ZERO_U8X; v_index_u32 < v_count_u32;
+		v_index_u32++) {
+			v_state_s32 = bmp280_iir_step(v_state_s32,
+			a_uncomp_temperature_s32[v_index_u32], v_shift_u8);
+			a_uncomp_temperature_s32[v_index_u32] =
+			bmp280_iir_output(v_state_s32);
+		}
+		iir->temperature_state = v_state_s32;
+		iir->temperature = bmp280_iir_output(v_state_s32);
+	}
+	return SUCCESS;
+}
+/* Effective resolution of a channel: osrs x1 gives 16 bits and each
+ * doubling of the number of averaged conversions adds one, up to the
+ * 20 bits of the data word, the same rule as the on-chip oversampling */
+static u8 bmp280_decim_resolution(u8 v_oversamp_u8, u16 v_ratio_u16)
+{
+	u8 v_bits_u8 = BMP280_ZERO_U8X;
+
+	if (v_oversamp_u8 == BMP280_OVERSAMPLING_SKIPPED)
+		return BMP280_ZERO_U8X;
+	if (v_oversamp_u8 > BMP280_OVERSAMP_16X)
+		v_oversamp_u8 = BMP280_OVERSAMP_16X;
+	v_bits_u8 = BMP280_RESOLUTION_X1_BITS + v_oversamp_u8
+	- BMP280_OVERSAMP_1X;
+	while (v_ratio_u16 > BMP280_ONE_U8X
+	&& v_bits_u8 < BMP280_RESOLUTION_MAX_BITS) {
+		v_ratio_u16 >>= BMP280_ONE_U8X;
+		v_bits_u8++;
+	}
+	return v_bits_u8;
+}
+/*!
+ *	@brief This API sets up a decimation stage that averages
+ *	(order 1) or CIC-decimates (order 2 and 3) raw codes taken at
+ *	a low oversampling and a high output data rate
+ *	@note Several stages with different ratios can be fed from one
+ *	stream, see bmp280_decim_push_all().
+ *	@note The effective resolution is reported in
+ *	resolution_pressure and resolution_temperature, following the
+ *	datasheet rule of one bit per doubling of the conversions.
+ *
+ *
+ *
+ *  @param decim : The decimation stage
+ *  @param v_ratio_u16 : Input samples per output sample
+ *  @param v_order_u8 : 1 for boxcar, up to BMP280_DECIM_MAX_ORDER
+ *  @param v_oversamp_pressure_u8 : osrs_p of the input stream
+ *  @param v_oversamp_temperature_u8 : osrs_t of the input stream
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> ratio^order above BMP280_DECIM_MAX_GAIN
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_decim_init(struct bmp280_decim_t *decim,
+u16 v_ratio_u16, u8 v_order_u8, u8 v_oversamp_pressure_u8,
+u8 v_oversamp_temperature_u8)
+{
+	u32 v_gain_u32 = BMP280_ONE_U8X;
+	u8 v_index_u8 = BMP280_ZERO_U8X;
+
+	if (decim == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_ratio_u16 == BMP280_ZERO_U8X || v_order_u8 == BMP280_ZERO_U8X
+	|| v_order_u8 > BMP280_DECIM_MAX_ORDER)
+		return E_BMP280_OUT_OF_RANGE;
+	for (v_index_u8 = BMP280_ZERO_U8X; v_index_u8 < v_order_u8;
+	v_index_u8++) {
+		v_gain_u32 *= v_ratio_u16;
+		if (v_gain_u32 > BMP280_DECIM_MAX_GAIN)
+			return E_BMP280_OUT_OF_RANGE;
+	}
+	for (v_index_u8 = BMP280_ZERO_U8X; v_index_u8 < BMP280_DECIM_MAX_ORDER;
+	v_index_u8++) {
+		decim->integ_pressure[v_index_u8] = BMP280_ZERO_U8X;
+		decim->comb_pressure[v_index_u8] = BMP280_ZERO_U8X;
+		decim->integ_temperature[v_index_u8] = BMP280_ZERO_U8X;
+		decim->comb_temperature[v_index_u8] = BMP280_ZERO_U8X;
+	}
+	decim->ratio = v_ratio_u16;
+	decim->phase = BMP280_ZERO_U8X;
+	decim->order = v_order_u8;
+	decim->settle = v_order_u8 - BMP280_ONE_U8X;
+	decim->gain = v_gain_u32;
+	decim->resolution_pressure = bmp280_decim_resolution(
+	v_oversamp_pressure_u8, v_ratio_u16);
+	decim->resolution_temperature = bmp280_decim_resolution(
+	v_oversamp_temperature_u8, v_ratio_u16);
+	decim->out.uncomp_pressure = BMP280_ZERO_U8X;
+	decim->out.uncomp_temperature = BMP280_ZERO_U8X;
+	decim->out.pressure = BMP280_ZERO_U8X;
+	decim->out.temperature = BMP280_ZERO_U8X;
+	decim->out.timestamp_usec = BMP280_ZERO_U8X;
+	decim->out.seq = BMP280_ZERO_U8X;
+	decim->out.status = BMP280_ZERO_U8X;
+	return SUCCESS;
+}
+/* Runs the combs of one channel and scales the result back to a
+ * 20 bit code, rounding to nearest */
+static s32 bmp280_decim_comb(u32 *a_integ_u32, u32 *a_comb_u32,
+u8 v_order_u8, u32 v_gain_u32)
+{
+	u32 v_value_u32 = a_integ_u32[v_order_u8 - BMP280_ONE_U8X];
+	u32 v_delay_u32 = BMP280_ZERO_U8X;
+	u8 v_index_u8 = BMP280_ZERO_U8X;
+
+	for (v_index_u8 = BMP280_ZERO_U8X; v_index_u8 < v_order_u8;
+	v_index_u8++) {
+		v_delay_u32 = v_value_u32;
+		v_value_u32 -= a_comb_u32[v_index_u8];
+		a_comb_u32[v_index_u8] = v_delay_u32;
+	}
+	return (s32)((v_value_u32 + (v_gain_u32 >> BMP280_ONE_U8X))
+	/ v_gain_u32);
+}
+/*!
+ *	@brief This API feeds one raw sample into a decimation stage
+ *	@note On output, decim->out holds the decimated raw codes, the
+ *	timestamp and status of the last input sample and an output
+ *	sequence number. The compensated fields are left to the caller,
+ *	e.g. bmp280_compensate_samples(), so that only emitted samples
+ *	are compensated.
+ *	@note With order 2 and 3 the first order - 1 outputs are dropped
+ *	while the combs fill.
+ *
+ *
+ *
+ *  @param decim : The decimation stage
+ *  @param sample : The input sample, only the raw fields are used
+ *  @param v_ready_u8 : 1 if decim->out holds a new sample
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_decim_push(struct bmp280_decim_t *decim,
+const struct bmp280_sample_t *sample, u8 *v_ready_u8)
+{
+	u32 v_pressure_u32 = BMP280_ZERO_U8X;
+	u32 v_temperature_u32 = BMP280_ZERO_U8X;
+	u8 v_index_u8 = BMP280_ZERO_U8X;
+
+	if (decim == BMP280_NULL || sample == BMP280_NULL
+	|| v_ready_u8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	*v_ready_u8 = BMP280_ZERO_U8X;
+	v_pressure_u32 = (u32)sample->uncomp_pressure;
+	v_temperature_u32 = (u32)sample->uncomp_temperature;
+	for (v_index_u8 = BMP280_ZERO_U8X; v_index_u8 < decim->order;
+	v_index_u8++) {
+		v_pressure_u32 += decim->integ_pressure[v_index_u8];
+		decim->integ_pressure[v_index_u8] = v_pressure_u32;
+		v_temperature_u32 += decim->integ_temperature[v_index_u8];
+		decim->integ_temperature[v_index_u8] = v_temperature_u32;
+	}
+	if (++decim->phase < decim->ratio)
+		return SUCCESS;
+	decim->phase = BMP280_ZERO_U8X;
+	decim->out.uncomp_pressure = bmp280_decim_comb(decim->integ_pressure,
+	decim->comb_pressure, decim->order, decim->gain);
+	decim->out.uncomp_temperature = bmp280_decim_comb(
+	decim->integ_temperature, decim->comb_temperature, decim->order,
+	decim->gain);
+	if (decim->settle > BMP280_ZERO_U8X) {
+		decim->settle--;
+		return SUCCESS;
+	}
+	decim->out.timestamp_usec = sample->timestamp_usec;
+	decim->out.status = sample->status;
+	decim->out.seq++;
+	*v_ready_u8 = BMP280_ONE_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API feeds one raw sample into several decimation
+ *	stages, e.g. one per output rate served from a single stream
+ *
+ *
+ *
+ *  @param a_decim : The decimation stages
+ *  @param v_count_u8 : Number of stages, at most 32
+ *  @param sample : The input sample
+ *  @param v_ready_u32 : Bit n is set if a_decim[n].out holds a
+ *	new sample
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> More than 32 stages
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_decim_push_all(
+struct bmp280_decim_t *a_decim, u8 v_count_u8,
+const struct bmp280_sample_t *sample, u32 *v_ready_u32)
+{
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = SUCCESS;
+	u8 v_ready_u8 = BMP280_ZERO_U8X;
+	u8 v_index_u8 = BMP280_ZERO_U8X;
+
+	if (a_decim == BMP280_NULL || v_ready_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_count_u8 > BMP280_DECIM_MAX_STAGES)
+		return E_BMP280_OUT_OF_RANGE;
+	*v_ready_u32 = BMP280_ZERO_U8X;
+	for (v_index_u8 = BMP280_ZERO_U8X; v_index_u8 < v_count_u8;
+	v_index_u8++) {
+		v_ready_u8 = BMP280_ZERO_U8X;
+		com_rslt = bmp280_first_error(com_rslt,
+		bmp280_decim_push(&a_decim[v_index_u8], sample, &v_ready_u8));
+		if (v_ready_u8)
+			*v_ready_u32 |= ((u32)BMP280_ONE_U8X << v_index_u8);
+	}
+	return com_rslt;
+}
+/*!
+ *	@brief This API initializes a fan-out hub on caller provided
+ *	sample and subscriber storage
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param a_buffer : Storage for v_capacity_u32 samples
+ *  @param v_capacity_u32 : Number of samples, a power of two
+ *  @param a_sub : Storage for v_sub_capacity_u16 subscriber pointers
+ *  @param v_sub_capacity_u16 : Maximum number of subscribers
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Capacity is not a power of two
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_init(struct bmp280_hub_t *hub,
+struct bmp280_sample_t *a_buffer, u32 v_capacity_u32,
+struct bmp280_hub_sub_t **a_sub, u16 v_sub_capacity_u16)
+{
+	if (hub == BMP280_NULL || a_buffer == BMP280_NULL ||
+	a_sub == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_capacity_u32 == BMP280_ZERO_U8X ||
+	(v_capacity_u32 & (v_capacity_u32 - BMP280_ONE_U8X)))
+		return E_BMP280_OUT_OF_RANGE;
+	hub->head = BMP280_ZERO_U8X;
+	hub->buffer = a_buffer;
+	hub->mask = v_capacity_u32 - BMP280_ONE_U8X;
+	hub->period_usec = BMP280_ZERO_U8X;
+	hub->sub = a_sub;
+	hub->count = BMP280_ZERO_U8X;
+	hub->capacity = v_sub_capacity_u16;
+	return SUCCESS;
+}
+/* Sets the acquisition period to the shortest requested period
+ * and derives the stride of every subscriber from it */
+static void bmp280_hub_restride(struct bmp280_hub_t *hub)
+{
+	u32 v_period_usec_u32 = BMP280_ZERO_U8X;
+	u16 v_index_u16 = BMP280_ZERO_U8X;
+
+	for (v_index_u16 = BMP280_ZERO_U8X; v_index_u16 < hub->count;
+	v_index_u16++)
+		if (v_period_usec_u32 == BMP280_ZERO_U8X ||
+		hub->sub[v_index_u16]->period_usec < v_period_usec_u32)
+			v_period_usec_u32 = hub->sub[v_index_u16]->period_usec;
+	if (v_period_usec_u32 == BMP280_ZERO_U8X)
+		return;
+	hub->period_usec = v_period_usec_u32;
+	for (v_index_u16 = BMP280_ZERO_U8X; v_index_u16 < hub->count;
+	v_index_u16++)
+		hub->sub[v_index_u16]->stride =
+		hub->sub[v_index_u16]->period_usec / v_period_usec_u32;
+}
+/*!
+ *	@brief This API adds a subscriber with its own sample period
+ *	@note The hub period_usec becomes the shortest period of all
+ *	subscribers; the acquisition engine has to sample the sensor
+ *	at that interval. Each subscriber receives every stride-th
+ *	sample, with stride = its period / the hub period.
+ *	@note Subscribers with the same stride see the same samples.
+ *	Adding or removing subscribers changes the strides, so it has
+ *	to be serialized with the subscribers reading the hub.
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param sub : The subscriber
+ *  @param v_period_usec_u32 : Requested sample period in us
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Hub full or zero period
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_subscribe(struct bmp280_hub_t *hub,
+struct bmp280_hub_sub_t *sub, u32 v_period_usec_u32)
+{
+	u32 v_head_u32 = BMP280_ZERO_U8X;
+
+	if (hub == BMP280_NULL || sub == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (hub->count >= hub->capacity ||
+	v_period_usec_u32 == BMP280_ZERO_U8X)
+		return E_BMP280_OUT_OF_RANGE;
+	sub->period_usec = v_period_usec_u32;
+	sub->lost_count = BMP280_ZERO_U8X;
+	hub->sub[hub->count++] = sub;
+	bmp280_hub_restride(hub);
+	/* start at the next sample on the stride grid */
+	v_head_u32 = hub->head;
+	sub->cursor = v_head_u32 + (sub->stride - v_head_u32 % sub->stride)
+	% sub->stride;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API removes a subscriber from the hub
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param sub : The subscriber
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Not subscribed
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_unsubscribe(struct bmp280_hub_t *hub,
+struct bmp280_hub_sub_t *sub)
+{
+	u16 v_index_u16 = BMP280_ZERO_U8X;
+
+	if (hub == BMP280_NULL || sub == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	for (v_index_u16 = BMP280_ZERO_U8X; v_index_u16 < hub->count;
+	v_index_u16++) {
+		if (hub->sub[v_index_u16] == sub) {
+			hub->sub[v_index_u16] = hub->sub[--hub->count];
+			bmp280_hub_restride(hub);
+			return SUCCESS;
+		}
+	}
+	return E_BMP280_OUT_OF_RANGE;
+}
+/*!
+ *	@brief This API publishes one sample to all subscribers;
+ *	called by the producer only
+ *	@note The producer never waits: the sample overwrites the
+ *	oldest slot whether or not every subscriber has read it.
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param sample : The sample to copy into the hub
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_publish(struct bmp280_hub_t *hub,
+const struct bmp280_sample_t *sample)
+{
+	u32 v_head_u32 = BMP280_ZERO_U8X;
+
+	if (hub == BMP280_NULL || sample == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	v_head_u32 = hub->head;
+	/* the previous index has to be visible before the slot it
+	 * retires is overwritten, or a reader could validate a
+	 * half written sample against the stale index */
+	BMP280_MEMORY_BARRIER();
+	hub->buffer[v_head_u32 & hub->mask] = *sample;
+	/* publish the slot before the index */
+	BMP280_MEMORY_BARRIER();
+	hub->head = v_head_u32 + BMP280_ONE_U8X;
+	return SUCCESS;
+}
+/* Moves a lapped cursor forward to the oldest slot that cannot be
+ * overwritten before head advances, keeping it on its stride grid */
+static u32 bmp280_bcast_catch_up(u32 v_mask_u32, u32 v_head_u32,
+u32 v_cursor_u32, u32 v_stride_u32, u32 *v_lost_u32)
+{
+	u32 v_skip_u32 = BMP280_ZERO_U8X;
+
+	if ((s32)(v_head_u32 - v_cursor_u32) <= (s32)v_mask_u32)
+		return v_cursor_u32;
+	v_skip_u32 = (v_head_u32 - v_mask_u32 - v_cursor_u32 + v_stride_u32
+	- BMP280_ONE_U8X) / v_stride_u32;
+	*v_lost_u32 += v_skip_u32;
+	return v_cursor_u32 + v_skip_u32 * v_stride_u32;
+}
+/* Copies up to v_max_u32 samples of a broadcast ring, every
+ * v_stride_u32-th slot from *v_cursor_u32 on. Slots reused by the
+ * producer during the copy are left out and counted as lost */
+static u32 bmp280_bcast_copy(const struct bmp280_sample_t *a_slot,
+u32 v_mask_u32, const volatile u32 *v_head_u32, u32 *v_cursor_u32,
+u32 v_stride_u32, u32 *v_lost_u32, struct bmp280_sample_t *a_sample,
+u32 v_max_u32)
+{
+	u32 v_end_u32 = *v_head_u32;
+	u32 v_cursor_local_u32 = BMP280_ZERO_U8X;
+	u32 v_index_u32 = BMP280_ZERO_U8X;
+
+	/* read the index before the slots */
+	BMP280_MEMORY_BARRIER();
+	v_cursor_local_u32 = bmp280_bcast_catch_up(v_mask_u32, v_end_u32,
+	*v_cursor_u32, v_stride_u32, v_lost_u32);
+	while (v_index_u32 < v_max_u32 &&
+	(s32)(v_end_u32 - v_cursor_local_u32) > BMP280_ZERO_U8X) {
+		a_sample[v_index_u32] = a_slot[v_cursor_local_u32 & v_mask_u32];
+		/* check the slot was not reused during the copy */
+		BMP280_MEMORY_BARRIER();
+		if (*v_head_u32 - v_cursor_local_u32 <= v_mask_u32)
+			v_index_u32++;
+		else
+			(*v_lost_u32)++;
+		v_cursor_local_u32 += v_stride_u32;
+	}
+	*v_cursor_u32 = v_cursor_local_u32;
+	return v_index_u32;
+}
+/*!
+ *	@brief This API returns the next sample of a subscriber in
+ *	place, without copying it
+ *	@note The slot may be overwritten while it is being used.
+ *	bmp280_hub_release() tells whether it was, in which case
+ *	anything derived from it has to be discarded.
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param sub : The subscriber
+ *  @param sample : The sample in the hub storage, BMP280_NULL if
+ *	no new sample is available
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_peek(struct bmp280_hub_t *hub,
+struct bmp280_hub_sub_t *sub, const struct bmp280_sample_t **sample)
+{
+	u32 v_head_u32 = BMP280_ZERO_U8X;
+
+	if (hub == BMP280_NULL || sub == BMP280_NULL || sample == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	v_head_u32 = hub->head;
+	/* read the index before the slot */
+	BMP280_MEMORY_BARRIER();
+	sub->cursor = bmp280_bcast_catch_up(hub->mask, v_head_u32,
+	sub->cursor, sub->stride, &sub->lost_count);
+	if ((s32)(v_head_u32 - sub->cursor) <= BMP280_ZERO_U8X)
+		*sample = BMP280_NULL;
+	else
+		*sample = &hub->buffer[sub->cursor & hub->mask];
+	return SUCCESS;
+}
+/*!
+ *	@brief This API moves a subscriber past the sample returned
+ *	by bmp280_hub_peek()
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param sub : The subscriber
+ *  @param v_valid_u8 : 1 if the sample was intact until the
+ *	release, 0 if the producer overwrote it
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_release(struct bmp280_hub_t *hub,
+struct bmp280_hub_sub_t *sub, u8 *v_valid_u8)
+{
+	if (hub == BMP280_NULL || sub == BMP280_NULL ||
+	v_valid_u8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	/* finish using the slot before re-reading the index */
+	BMP280_MEMORY_BARRIER();
+	*v_valid_u8 = (hub->head - sub->cursor <= hub->mask);
+	if (!*v_valid_u8)
+		sub->lost_count++;
+	sub->cursor += sub->stride;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API copies up to v_max_u32 samples of a
+ *	subscriber's view in one batch
+ *	@note Samples overwritten during the copy are left out and
+ *	counted in lost_count.
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param sub : The subscriber
+ *  @param a_sample : Destination for the samples
+ *  @param v_max_u32 : Size of the destination
+ *  @param v_count_u32 : Number of samples copied
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_pop_batch(struct bmp280_hub_t *hub,
+struct bmp280_hub_sub_t *sub, struct bmp280_sample_t *a_sample,
+u32 v_max_u32, u32 *v_count_u32)
+{
+	u32 v_cursor_u32 = BMP280_ZERO_U8X;
+
+	if (hub == BMP280_NULL || sub == BMP280_NULL ||
+	a_sample == BMP280_NULL || v_count_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	v_cursor_u32 = sub->cursor;
+	*v_count_u32 = bmp280_bcast_copy(hub->buffer, hub->mask, &hub->head,
+	&v_cursor_u32, sub->stride, &sub->lost_count, a_sample, v_max_u32);
+	sub->cursor = v_cursor_u32;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API initializes a table of latest samples, e.g.
+ *	in a shared memory segment, and marks it valid last
+ *
+ *
+ *
+ *  @param table : The table
+ *  @param v_count_u8 : Number of slots in use
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> More than BMP280_LATEST_MAX_SENSORS slots
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_latest_table_init(
+struct bmp280_latest_table_t *table, u8 v_count_u8)
+{
+	struct bmp280_sample_t sample = {BMP280_ZERO_U8X};
+	u8 v_index_u8 = BMP280_ZERO_U8X;
+
+	if (table == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_count_u8 > BMP280_LATEST_MAX_SENSORS)
+		return E_BMP280_OUT_OF_RANGE;
+	table->magic = BMP280_ZERO_U8X;
+	for (v_index_u8 = BMP280_ZERO_U8X;
+	v_index_u8 < BMP280_LATEST_MAX_SENSORS; v_index_u8++) {
+		table->slot[v_index_u8].seq = BMP280_ZERO_U8X;
+		table->slot[v_index_u8].sample = sample;
+	}
+	table->count = v_count_u8;
+	/* the slots are valid before the magic is */
+	BMP280_MEMORY_BARRIER();
+	table->magic = BMP280_LATEST_MAGIC;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API stores the latest sample of a sensor;
+ *	called by the single writer of the slot only
+ *	@note The writer never waits for readers.
+ *
+ *
+ *
+ *  @param slot : The slot of the sensor
+ *  @param sample : The sample to publish
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_latest_write(struct bmp280_latest_t *slot,
+const struct bmp280_sample_t *sample)
+{
+	u32 v_seq_u32 = BMP280_ZERO_U8X;
+
+	if (slot == BMP280_NULL || sample == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	v_seq_u32 = slot->seq;
+	slot->seq = v_seq_u32 + BMP280_ONE_U8X;
+	/* the odd sequence is visible before the data changes */
+	BMP280_MEMORY_BARRIER();
+	slot->sample = *sample;
+	BMP280_MEMORY_BARRIER();
+	slot->seq = v_seq_u32 + BMP280_TWO_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API copies the latest sample of a sensor
+ *	@note Readers never block the writer nor each other. A copy
+ *	that overlaps a write is retried, at most
+ *	BMP280_LATEST_READ_RETRY times, so the read is bounded.
+ *	@note sample->seq tells whether the sample is new to the
+ *	caller; a slot never written reads as all zero.
+ *
+ *
+ *
+ *  @param slot : The slot of the sensor
+ *  @param sample : The copied sample
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> The writer kept the slot busy
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_latest_read(
+const struct bmp280_latest_t *slot, struct bmp280_sample_t *sample)
+{
+	u32 v_seq_u32 = BMP280_ZERO_U8X;
+	u8 v_retry_u8 = BMP280_ZERO_U8X;
+
+	if (slot == BMP280_NULL || sample == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	for (v_retry_u8 = BMP280_ZERO_U8X;
+	v_retry_u8 < BMP280_LATEST_READ_RETRY; v_retry_u8++) {
+		v_seq_u32 = slot->seq;
+		if (v_seq_u32 & BMP280_ONE_U8X)
+			continue;
+		BMP280_MEMORY_BARRIER();
+		*sample = slot->sample;
+		/* the copy completes before the sequence is checked */
+		BMP280_MEMORY_BARRIER();
+		if (slot->seq == v_seq_u32)
+			return SUCCESS;
+	}
+	return ERROR;
+}
+/*!
+ *	@brief This API returns the size in bytes of a shared memory
+ *	ring, header included
+ *
+ *
+ *
+ *  @param v_capacity_u32 : Number of samples, a power of two
+ *  @param v_size_u32 : The size to map
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Capacity is not a power of two
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_shm_ring_size(u32 v_capacity_u32,
+u32 *v_size_u32)
+{
+	if (v_size_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_capacity_u32 == BMP280_ZERO_U8X ||
+	(v_capacity_u32 & (v_capacity_u32 - BMP280_ONE_U8X)))
+		return E_BMP280_OUT_OF_RANGE;
+	*v_size_u32 = sizeof(struct bmp280_shm_ring_t) +
+	v_capacity_u32 * sizeof(struct bmp280_sample_t);
+	return SUCCESS;
+}
+/*!
+ *	@brief This API initializes a shared memory ring in a mapping
+ *	of bmp280_shm_ring_size() bytes and marks it valid last
+ *
+ *
+ *
+ *  @param ring : The ring at the start of the mapping
+ *  @param v_capacity_u32 : Number of samples, a power of two
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Capacity is not a power of two
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_shm_ring_init(
+struct bmp280_shm_ring_t *ring, u32 v_capacity_u32)
+{
+	if (ring == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_capacity_u32 == BMP280_ZERO_U8X ||
+	(v_capacity_u32 & (v_capacity_u32 - BMP280_ONE_U8X)))
+		return E_BMP280_OUT_OF_RANGE;
+	ring->magic = BMP280_ZERO_U8X;
+	ring->mask = v_capacity_u32 - BMP280_ONE_U8X;
+	ring->head = BMP280_ZERO_U8X;
+	BMP280_MEMORY_BARRIER();
+	ring->magic = BMP280_SHM_RING_MAGIC;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API publishes one sample to a shared memory ring;
+ *	called by the single writer only
+ *	@note The writer never waits: the sample overwrites the
+ *	oldest slot whether or not every reader has read it.
+ *
+ *
+ *
+ *  @param ring : The ring
+ *  @param sample : The sample to copy into the ring
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_shm_ring_publish(
+struct bmp280_shm_ring_t *ring, const struct bmp280_sample_t *sample)
+{
+	u32 v_head_u32 = BMP280_ZERO_U8X;
+
+	if (ring == BMP280_NULL || sample == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	v_head_u32 = ring->head;
+	/* the previous index has to be visible before the slot it
+	 * retires is overwritten */
+	BMP280_MEMORY_BARRIER();
+	BMP280_SHM_RING_SLOT(ring)[v_head_u32 & ring->mask] = *sample;
+	/* publish the slot before the index */
+	BMP280_MEMORY_BARRIER();
+	ring->head = v_head_u32 + BMP280_ONE_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API copies up to v_max_u32 samples from a shared
+ *	memory ring, starting at the reader's own cursor
+ *	@note A new reader starts with its cursor at ring->head. A
+ *	reader that falls more than the capacity behind skips ahead;
+ *	the skipped samples are added to its lost count.
+ *
+ *
+ *
+ *  @param ring : The ring
+ *  @param v_cursor_u32 : The cursor of the reader
+ *  @param a_sample : Destination for the samples
+ *  @param v_max_u32 : Size of the destination
+ *  @param v_count_u32 : Number of samples copied
+ *  @param v_lost_u32 : Lost count of the reader
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> The ring is not initialized
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_shm_ring_read(
+const struct bmp280_shm_ring_t *ring, u32 *v_cursor_u32,
+struct bmp280_sample_t *a_sample, u32 v_max_u32, u32 *v_count_u32,
+u32 *v_lost_u32)
+{
+	if (ring == BMP280_NULL || v_cursor_u32 == BMP280_NULL ||
+	a_sample == BMP280_NULL || v_count_u32 == BMP280_NULL ||
+	v_lost_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (ring->magic != BMP280_SHM_RING_MAGIC)
+		return ERROR;
+	*v_count_u32 = bmp280_bcast_copy(BMP280_SHM_RING_SLOT(ring),
+	ring->mask, &ring->head, v_cursor_u32, BMP280_ONE_U8X, v_lost_u32,
+	a_sample, v_max_u32);
+	return SUCCESS;
+}
+/* Little endian field access of the frames */
+static void bmp280_frame_put_u32(u8 *a_data_u8, u32 v_value_u32)
+{
+	a_data_u8[INDEX_ZERO] = (u8)v_value_u32;
+	a_data_u8[INDEX_ONE] = (u8)(v_value_u32 >> SHIFT_LEFT_8_POSITION);
+	a_data_u8[INDEX_TWO] = (u8)(v_value_u32 >> SHIFT_LEFT_16_POSITION);
+	a_data_u8[INDEX_THREE] = (u8)(v_value_u32 >> SHIFT_LEFT_24_POSITION);
+}
+static u32 bmp280_frame_get_u32(const u8 *a_data_u8)
+{
+	return (u32)a_data_u8[INDEX_ZERO] |
+	((u32)a_data_u8[INDEX_ONE] << SHIFT_LEFT_8_POSITION) |
+	((u32)a_data_u8[INDEX_TWO] << SHIFT_LEFT_16_POSITION) |
+	((u32)a_data_u8[INDEX_THREE] << SHIFT_LEFT_24_POSITION);
+}
+/*!
+ *	@brief This API writes a frame header
+ *
+ *
+ *
+ *  @param a_frame_u8 : The frame, BMP280_FRAME_HEADER_LEN bytes
+ *  @param v_type_u8 : BMP280_FRAME_SUBSCRIBE to _STATUS
+ *  @param v_sensor_u8 : Sensor the frame refers to
+ *  @param v_payload_len_u16 : Length of the payload that follows
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_put_header(u8 *a_frame_u8,
+u8 v_type_u8, u8 v_sensor_u8, u16 v_payload_len_u16)
+{
+	if (a_frame_u8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	a_frame_u8[INDEX_ZERO] = v_type_u8;
+	a_frame_u8[INDEX_ONE] = v_sensor_u8;
+	a_frame_u8[INDEX_TWO] = (u8)v_payload_len_u16;
+	a_frame_u8[INDEX_THREE] = (u8)(v_payload_len_u16 >>
+	SHIFT_LEFT_8_POSITION);
+	return SUCCESS;
+}
+/*!
+ *	@brief This API reads a frame header and checks that the
+ *	whole payload is present
+ *
+ *
+ *
+ *  @param a_frame_u8 : The received bytes
+ *  @param v_len_u32 : Number of received bytes
+ *  @param v_type_u8 : The frame type
+ *  @param v_sensor_u8 : The sensor
+ *  @param v_payload_len_u16 : Length of the payload at
+ *	a_frame_u8 + BMP280_FRAME_HEADER_LEN
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Truncated frame
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_get_header(const u8 *a_frame_u8,
+u32 v_len_u32, u8 *v_type_u8, u8 *v_sensor_u8, u16 *v_payload_len_u16)
+{
+	if (a_frame_u8 == BMP280_NULL || v_type_u8 == BMP280_NULL ||
+	v_sensor_u8 == BMP280_NULL || v_payload_len_u16 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_len_u32 < BMP280_FRAME_HEADER_LEN)
+		return E_BMP280_OUT_OF_RANGE;
+	*v_type_u8 = a_frame_u8[INDEX_ZERO];
+	*v_sensor_u8 = a_frame_u8[INDEX_ONE];
+	*v_payload_len_u16 = (u16)(a_frame_u8[INDEX_TWO] |
+	(a_frame_u8[INDEX_THREE] << SHIFT_LEFT_8_POSITION));
+	if (v_len_u32 - BMP280_FRAME_HEADER_LEN < *v_payload_len_u16)
+		return E_BMP280_OUT_OF_RANGE;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API writes a complete subscribe frame of
+ *	BMP280_FRAME_HEADER_LEN + BMP280_FRAME_SUBSCRIBE_LEN bytes
+ *
+ *
+ *
+ *  @param a_frame_u8 : The frame
+ *  @param v_sensor_u8 : The sensor
+ *  @param v_period_usec_u32 : Requested sample period in us
+ *  @param v_batch_u8 : Samples per delivered frame
+ *  @param v_flags_u8 : 0 or BMP280_FRAME_FLAG_SHM
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_put_subscribe(u8 *a_frame_u8,
+u8 v_sensor_u8, u32 v_period_usec_u32, u8 v_batch_u8, u8 v_flags_u8)
+{
+	if (a_frame_u8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	bmp280_frame_put_header(a_frame_u8, BMP280_FRAME_SUBSCRIBE,
+	v_sensor_u8, BMP280_FRAME_SUBSCRIBE_LEN);
+	a_frame_u8 += BMP280_FRAME_HEADER_LEN;
+	bmp280_frame_put_u32(a_frame_u8, v_period_usec_u32);
+	a_frame_u8[INDEX_FOUR] = v_batch_u8;
+	a_frame_u8[INDEX_FIVE] = v_flags_u8;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API reads the payload of a subscribe frame
+ *
+ *
+ *
+ *  @param a_payload_u8 : The payload
+ *  @param v_payload_len_u16 : Length of the payload
+ *  @param v_period_usec_u32 : Requested sample period in us
+ *  @param v_batch_u8 : Samples per delivered frame
+ *  @param v_flags_u8 : 0 or BMP280_FRAME_FLAG_SHM
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Payload too short
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_get_subscribe(
+const u8 *a_payload_u8, u16 v_payload_len_u16, u32 *v_period_usec_u32,
+u8 *v_batch_u8, u8 *v_flags_u8)
+{
+	if (a_payload_u8 == BMP280_NULL || v_period_usec_u32 == BMP280_NULL ||
+	v_batch_u8 == BMP280_NULL || v_flags_u8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_payload_len_u16 < BMP280_FRAME_SUBSCRIBE_LEN)
+		return E_BMP280_OUT_OF_RANGE;
+	*v_period_usec_u32 = bmp280_frame_get_u32(a_payload_u8);
+	*v_batch_u8 = a_payload_u8[INDEX_FOUR];
+	*v_flags_u8 = a_payload_u8[INDEX_FIVE];
+	return SUCCESS;
+}
+/*!
+ *	@brief This API writes a complete shared memory ring frame of
+ *	BMP280_FRAME_HEADER_LEN + BMP280_FRAME_SHM_RING_LEN bytes; the
+ *	file descriptor of the ring travels beside it
+ *
+ *
+ *
+ *  @param a_frame_u8 : The frame
+ *  @param v_sensor_u8 : The sensor
+ *  @param v_capacity_u32 : Capacity of the ring in samples
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_put_shm_ring(u8 *a_frame_u8,
+u8 v_sensor_u8, u32 v_capacity_u32)
+{
+	if (a_frame_u8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	bmp280_frame_put_header(a_frame_u8, BMP280_FRAME_SHM_RING,
+	v_sensor_u8, BMP280_FRAME_SHM_RING_LEN);
+	bmp280_frame_put_u32(a_frame_u8 + BMP280_FRAME_HEADER_LEN,
+	v_capacity_u32);
+	return SUCCESS;
+}
+/*!
+ *	@brief This API reads the payload of a shared memory ring frame
+ *
+ *
+ *
+ *  @param a_payload_u8 : The payload
+ *  @param v_payload_len_u16 : Length of the payload
+ *  @param v_capacity_u32 : Capacity of the ring in samples
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Payload too short
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_get_shm_ring(
+const u8 *a_payload_u8, u16 v_payload_len_u16, u32 *v_capacity_u32)
+{
+	if (a_payload_u8 == BMP280_NULL || v_capacity_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_payload_len_u16 < BMP280_FRAME_SHM_RING_LEN)
+		return E_BMP280_OUT_OF_RANGE;
+	*v_capacity_u32 = bmp280_frame_get_u32(a_payload_u8);
+	return SUCCESS;
+}
+/*!
+ *	@brief This API writes a complete status frame of
+ *	BMP280_FRAME_HEADER_LEN + BMP280_FRAME_STATUS_LEN bytes, the
+ *	answer to a request that has no other reply
+ *
+ *
+ *
+ *  @param a_frame_u8 : The frame
+ *  @param v_sensor_u8 : The sensor
+ *  @param v_status_s8 : 0 on success, else the error code
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_put_status(u8 *a_frame_u8,
+u8 v_sensor_u8, s8 v_status_s8)
+{
+	if (a_frame_u8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	bmp280_frame_put_header(a_frame_u8, BMP280_FRAME_STATUS,
+	v_sensor_u8, BMP280_FRAME_STATUS_LEN);
+	a_frame_u8[BMP280_FRAME_HEADER_LEN] = (u8)v_status_s8;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API reads the payload of a status frame
+ *
+ *
+ *
+ *  @param a_payload_u8 : The payload
+ *  @param v_payload_len_u16 : Length of the payload
+ *  @param v_status_s8 : 0 on success, else the error code
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Payload too short
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_get_status(
+const u8 *a_payload_u8, u16 v_payload_len_u16, s8 *v_status_s8)
+{
+	if (a_payload_u8 == BMP280_NULL || v_status_s8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_payload_len_u16 < BMP280_FRAME_STATUS_LEN)
+		return E_BMP280_OUT_OF_RANGE;
+	*v_status_s8 = (s8)a_payload_u8[INDEX_ZERO];
+	return SUCCESS;
+}
+/*!
+ *	@brief This API writes a samples frame carrying a batch of
+ *	samples of one sensor
+ *	@note Each sample takes BMP280_FRAME_SAMPLE_LEN bytes, the
+ *	20 bit raw codes are packed into 5 bytes.
+ *
+ *
+ *
+ *  @param a_frame_u8 : The frame
+ *  @param v_size_u32 : Size of the frame buffer
+ *  @param v_sensor_u8 : The sensor
+ *  @param a_sample : The samples
+ *  @param v_count_u16 : Number of samples
+ *  @param v_frame_len_u32 : Length of the written frame
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> The samples do not fit
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_put_samples(u8 *a_frame_u8,
+u32 v_size_u32, u8 v_sensor_u8, const struct bmp280_sample_t *a_sample,
+u16 v_count_u16, u32 *v_frame_len_u32)
+{
+	u32 v_payload_len_u32 = (u32)v_count_u16 * BMP280_FRAME_SAMPLE_LEN;
+	u32 v_mask_u32 = BMP280_UNCOMP_CODE_COUNT - BMP280_ONE_U8X;
+	u32 v_pressure_u32 = BMP280_ZERO_U8X;
+	u32 v_temperature_u32 = BMP280_ZERO_U8X;
+	u16 v_index_u16 = BMP280_ZERO_U8X;
+	u8 *v_data_u8 = BMP280_NULL;
+
+	if (a_frame_u8 == BMP280_NULL || a_sample == BMP280_NULL ||
+	v_frame_len_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_payload_len_u32 > BMP280_FRAME_MAX_PAYLOAD ||
+	v_size_u32 < BMP280_FRAME_HEADER_LEN + v_payload_len_u32)
+		return E_BMP280_OUT_OF_RANGE;
+	bmp280_frame_put_header(a_frame_u8, BMP280_FRAME_SAMPLES,
+	v_sensor_u8, (u16)v_payload_len_u32);
+	v_data_u8 = a_frame_u8 + BMP280_FRAME_HEADER_LEN;
+	for (v_index_u16 = BMP280_ZERO_U8X; v_index_u16 < v_count_u16;
+	v_index_u16++) {
+		v_pressure_u32 = (u32)a_sample[v_index_u16].uncomp_pressure
+		& v_mask_u32;
+		v_temperature_u32 = (u32)a_sample[v_index_u16].uncomp_temperature
+		& v_mask_u32;
+		/* pressure in bits 0..19, temperature in bits 20..39 */
+		bmp280_frame_put_u32(v_data_u8, v_pressure_u32 |
+		(v_temperature_u32 << SHIFT_LEFT_20_POSITION));
+		v_data_u8[INDEX_FOUR] = (u8)(v_temperature_u32 >>
+		SHIFT_RIGHT_12_POSITION);
+		bmp280_frame_put_u32(&v_data_u8[BMP280_FRAME_SAMPLE_PRESSURE],
+		a_sample[v_index_u16].pressure);
+		bmp280_frame_put_u32(&v_data_u8[BMP280_FRAME_SAMPLE_TEMPERATURE],
+		(u32)a_sample[v_index_u16].temperature);
+		bmp280_frame_put_u32(&v_data_u8[BMP280_FRAME_SAMPLE_TIMESTAMP],
+		a_sample[v_index_u16].timestamp_usec);
+		bmp280_frame_put_u32(&v_data_u8[BMP280_FRAME_SAMPLE_SEQ],
+		a_sample[v_index_u16].seq);
+		v_data_u8[BMP280_FRAME_SAMPLE_STATUS] =
+		a_sample[v_index_u16].status;
+		v_data_u8 += BMP280_FRAME_SAMPLE_LEN;
+	}
+	*v_frame_len_u32 = BMP280_FRAME_HEADER_LEN + v_payload_len_u32;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API reads one sample of a samples frame
+ *
+ *
+ *
+ *  @param a_payload_u8 : The payload
+ *  @param v_payload_len_u16 : Length of the payload
+ *  @param v_index_u16 : Index of the sample in the frame
+ *  @param sample : The sample
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Index past the payload
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_get_sample(const u8 *a_payload_u8,
+u16 v_payload_len_u16, u16 v_index_u16, struct bmp280_sample_t *sample)
+{
+	const u8 *v_data_u8 = BMP280_NULL;
+	u32 v_raw_u32 = BMP280_ZERO_U8X;
+
+	if (a_payload_u8 == BMP280_NULL || sample == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if ((u32)(v_index_u16 + BMP280_ONE_U8X) * BMP280_FRAME_SAMPLE_LEN
+	> v_payload_len_u16)
+		return E_BMP280_OUT_OF_RANGE;
+	v_data_u8 = a_payload_u8 + (u32)v_index_u16 * BMP280_FRAME_SAMPLE_LEN;
+	v_raw_u32 = bmp280_frame_get_u32(v_data_u8);
+	sample->uncomp_pressure = (s32)(v_raw_u32 &
+	(BMP280_UNCOMP_CODE_COUNT - BMP280_ONE_U8X));
+	sample->uncomp_temperature = (s32)((v_raw_u32 >>
+	SHIFT_RIGHT_20_POSITION) | ((u32)v_data_u8[INDEX_FOUR] <<
+	SHIFT_LEFT_12_POSITION));
+	sample->pressure = bmp280_frame_get_u32(
+	&v_data_u8[BMP280_FRAME_SAMPLE_PRESSURE]);
+	sample->temperature = (s32)bmp280_frame_get_u32(
+	&v_data_u8[BMP280_FRAME_SAMPLE_TEMPERATURE]);
+	sample->timestamp_usec = bmp280_frame_get_u32(
+	&v_data_u8[BMP280_FRAME_SAMPLE_TIMESTAMP]);
+	sample->seq = bmp280_frame_get_u32(
+	&v_data_u8[BMP280_FRAME_SAMPLE_SEQ]);
+	sample->status = v_data_u8[BMP280_FRAME_SAMPLE_STATUS];
+	return SUCCESS;
+}
+#if defined(BMP280_ENABLE_INT64) && defined(BMP280_64BITSUPPORT_PRESENT)
+/* Little endian u16 field access of the log blocks */
+static void bmp280_log_put_u16(u8 *a_data_u8, u16 v_value_u16)
+{
+	a_data_u8[INDEX_ZERO] = (u8)v_value_u16;
+	a_data_u8[INDEX_ONE] = (u8)(v_value_u16 >> SHIFT_LEFT_8_POSITION);
+}
+static u16 bmp280_log_get_u16(const u8 *a_data_u8)
+{
+	return (u16)(a_data_u8[INDEX_ZERO] |
+	(a_data_u8[INDEX_ONE] << SHIFT_LEFT_8_POSITION));
+}
+/* Little endian u64 of the index, as two u32 */
+static void bmp280_log_put_u64(u8 *a_data_u8, u64 v_value_u64)
+{
+	bmp280_frame_put_u32(&a_data_u8[INDEX_ZERO], (u32)v_value_u64);
+	bmp280_frame_put_u32(&a_data_u8[INDEX_FOUR],
+	(u32)(v_value_u64 >> SHIFT_RIGHT_32_POSITION));
+}
+static u64 bmp280_log_get_u64(const u8 *a_data_u8)
+{
+	return (u64)bmp280_frame_get_u32(&a_data_u8[INDEX_ZERO]) |
+	((u64)bmp280_frame_get_u32(&a_data_u8[INDEX_FOUR]) <<
+	SHIFT_LEFT_32_POSITION);
+}
+/* Maps signed deltas to unsigned codes, small magnitudes first */
+static u32 bmp280_log_zigzag(s32 v_value_s32)
+{
+	return ((u32)v_value_s32 << SHIFT_LEFT_1_POSITION) ^
+	(u32)(v_value_s32 >> SHIFT_RIGHT_31_POSITION);
+}
+static s32 bmp280_log_unzigzag(u32 v_code_u32)
+{
+	return (s32)((v_code_u32 >> SHIFT_RIGHT_1_POSITION) ^
+	(BMP280_ZERO_U8X - (v_code_u32 & BMP280_ONE_U8X)));
+}
+/* Delta of sample v_index_u32 (>= 1) in one stream of a block */
+static s32 bmp280_log_delta(const struct bmp280_sample_t *a_sample,
+u32 v_index_u32, u8 v_stream_u8, u32 v_base_delta_u32)
+{
+	u32 v_prev_delta_u32 = v_base_delta_u32;
+
+	switch (v_stream_u8) {
+	case BMP280_LOG_STREAM_TIME:
+		if (v_index_u32 > BMP280_ONE_U8X)
+			v_prev_delta_u32 =
+			a_sample[v_index_u32 - BMP280_ONE_U8X].timestamp_usec -
+			a_sample[v_index_u32 - BMP280_TWO_U8X].timestamp_usec;
+		return (s32)(a_sample[v_index_u32].timestamp_usec -
+		a_sample[v_index_u32 - BMP280_ONE_U8X].timestamp_usec -
+		v_prev_delta_u32);
+	case BMP280_LOG_STREAM_PRESSURE:
+		return a_sample[v_index_u32].uncomp_pressure -
+		a_sample[v_index_u32 - BMP280_ONE_U8X].uncomp_pressure;
+	default:
+		return a_sample[v_index_u32].uncomp_temperature -
+		a_sample[v_index_u32 - BMP280_ONE_U8X].uncomp_temperature;
+	}
+}
+/*!
+ *	@brief This API returns the largest size in bytes of a log
+ *	block of v_count_u16 samples, i.e. the buffer to provide to
+ *	bmp280_log_encode_block()
+ *
+ *
+ *
+ *  @param v_count_u16 : Number of samples
+ *  @param v_size_u32 : The size
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_block_bound(u16 v_count_u16,
+u32 *v_size_u32)
+{
+	if (v_size_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	*v_size_u32 = BMP280_LOG_HEADER_LEN + ((u32)v_count_u16 *
+	BMP280_LOG_STREAMS * BMP280_LOG_MAX_WIDTH / BMP280_EIGHT_U8X) +
+	BMP280_LOG_ALIGN;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API encodes samples of one device into a log block
+ *	@note Only the raw codes, timestamps and the first sequence
+ *	number are stored; the block carries the calibration and
+ *	configuration of dev so that compensation can be done when
+ *	the log is read.
+ *	@note A typical block needs 2 to 3 bytes per sample: at osrs
+ *	x1 the four zero bits of the XLSB are stripped from the
+ *	deltas, and a steady sampling grid leaves only the timing
+ *	jitter in the delta-of-delta.
+ *
+ *
+ *
+ *  @param dev : Device the samples were taken from
+ *  @param a_sample : The samples, in time order
+ *  @param v_count_u16 : Number of samples, at least 1
+ *  @param a_block_u8 : Destination, 8 byte aligned
+ *  @param v_size_u32 : Size of the destination, see
+ *	bmp280_log_block_bound()
+ *  @param v_len_u32 : Size of the block, a multiple of
+ *	BMP280_LOG_ALIGN
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> No samples or destination too small
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_encode_block(
+const struct bmp280_t *dev, const struct bmp280_sample_t *a_sample,
+u16 v_count_u16, u8 *a_block_u8, u32 v_size_u32, u32 *v_len_u32)
+{
+	const struct bmp280_calib_param_t *calib = BMP280_NULL;
+	u8 a_width_u8[BMP280_LOG_STREAMS];
+	u8 a_shift_u8[BMP280_LOG_STREAMS];
+	u32 v_base_delta_u32 = BMP280_ZERO_U8X;
+	u32 v_bits_u32 = BMP280_ZERO_U8X;
+	u32 v_code_u32 = BMP280_ZERO_U8X;
+	u32 v_payload_len_u32 = BMP280_ZERO_U8X;
+	u32 v_index_u32 = BMP280_ZERO_U8X;
+	u64 v_acc_u64 = BMP280_ZERO_U8X;
+	u8 *v_out_u8 = BMP280_NULL;
+	u8 v_fill_u8 = BMP280_ZERO_U8X;
+	u8 v_stream_u8 = BMP280_ZERO_U8X;
+	s32 v_delta_s32 = BMP280_ZERO_U8X;
+
+	if (dev == BMP280_NULL || a_sample == BMP280_NULL ||
+	a_block_u8 == BMP280_NULL || v_len_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_count_u16 == BMP280_ZERO_U8X)
+		return E_BMP280_OUT_OF_RANGE;
+	if (v_count_u16 > BMP280_ONE_U8X)
+		v_base_delta_u32 = a_sample[INDEX_ONE].timestamp_usec -
+		a_sample[INDEX_ZERO].timestamp_usec;
+	/* first pass: common trailing zeros and width of each stream */
+	for (v_stream_u8 = BMP280_ZERO_U8X;
+	v_stream_u8 < BMP280_LOG_STREAMS; v_stream_u8++) {
+		v_bits_u32 = BMP280_ZERO_U8X;
+		for (v_index_u32 = BMP280_ONE_U8X; v_index_u32 < v_count_u16;
+		v_index_u32++)
+			v_bits_u32 |= (u32)bmp280_log_delta(a_sample,
+			v_index_u32, v_stream_u8, v_base_delta_u32);
+		a_shift_u8[v_stream_u8] = BMP280_ZERO_U8X;
+		while (v_bits_u32 != BMP280_ZERO_U8X &&
+		!(v_bits_u32 & BMP280_ONE_U8X)) {
+			v_bits_u32 >>= BMP280_ONE_U8X;
+			a_shift_u8[v_stream_u8]++;
+		}
+		v_bits_u32 = BMP280_ZERO_U8X;
+		for (v_index_u32 = BMP280_ONE_U8X; v_index_u32 < v_count_u16;
+		v_index_u32++)
+			v_bits_u32 |= bmp280_log_zigzag(bmp280_log_delta(
+			a_sample, v_index_u32, v_stream_u8, v_base_delta_u32)
+			>> a_shift_u8[v_stream_u8]);
+		a_width_u8[v_stream_u8] = BMP280_ZERO_U8X;
+		while (v_bits_u32 != BMP280_ZERO_U8X) {
+			v_bits_u32 >>= BMP280_ONE_U8X;
+			a_width_u8[v_stream_u8]++;
+		}
+		v_payload_len_u32 += (u32)a_width_u8[v_stream_u8] *
+		(v_count_u16 - BMP280_ONE_U8X);
+	}
+	v_payload_len_u32 = (v_payload_len_u32 + BMP280_LOG_ALIGN *
+	BMP280_EIGHT_U8X - BMP280_ONE_U8X) / (BMP280_LOG_ALIGN *
+	BMP280_EIGHT_U8X) * BMP280_LOG_ALIGN;
+	if (v_size_u32 < BMP280_LOG_HEADER_LEN + v_payload_len_u32)
+		return E_BMP280_OUT_OF_RANGE;
+	/* header */
+	for (v_index_u32 = BMP280_ZERO_U8X;
+	v_index_u32 < BMP280_LOG_HEADER_LEN; v_index_u32++)
+		a_block_u8[v_index_u32] = BMP280_ZERO_U8X;
+	bmp280_frame_put_u32(&a_block_u8[BMP280_LOG_OFFSET_MAGIC],
+	BMP280_LOG_MAGIC);
+	bmp280_frame_put_u32(&a_block_u8[BMP280_LOG_OFFSET_PAYLOAD_LEN],
+	v_payload_len_u32);
+	bmp280_log_put_u16(&a_block_u8[BMP280_LOG_OFFSET_COUNT], v_count_u16);
+	a_block_u8[BMP280_LOG_OFFSET_VERSION] = BMP280_LOG_VERSION;
+	a_block_u8[BMP280_LOG_OFFSET_OVERSAMP_P] = dev->oversamp_pressure;
+	a_block_u8[BMP280_LOG_OFFSET_OVERSAMP_T] = dev->oversamp_temperature;
+	a_block_u8[BMP280_LOG_OFFSET_FILTER] = dev->filter;
+	bmp280_frame_put_u32(&a_block_u8[BMP280_LOG_OFFSET_TIMESTAMP],
+	a_sample[INDEX_ZERO].timestamp_usec);
+	bmp280_frame_put_u32(&a_block_u8[BMP280_LOG_OFFSET_BASE_DELTA],
+	v_base_delta_u32);
+	bmp280_frame_put_u32(&a_block_u8[BMP280_LOG_OFFSET_SEQ],
+	a_sample[INDEX_ZERO].seq);
+	bmp280_frame_put_u32(&a_block_u8[BMP280_LOG_OFFSET_PRESSURE],
+	(u32)a_sample[INDEX_ZERO].uncomp_pressure);
+	bmp280_frame_put_u32(&a_block_u8[BMP280_LOG_OFFSET_TEMPERATURE],
+	(u32)a_sample[INDEX_ZERO].uncomp_temperature);
+	for (v_stream_u8 = BMP280_ZERO_U8X;
+	v_stream_u8 < BMP280_LOG_STREAMS; v_stream_u8++) {
+		a_block_u8[BMP280_LOG_OFFSET_WIDTH + v_stream_u8] =
+		a_width_u8[v_stream_u8];
+		a_block_u8[BMP280_LOG_OFFSET_SHIFT + v_stream_u8] =
+		a_shift_u8[v_stream_u8];
+	}
+	calib = &dev->calib_param;
+	v_out_u8 = &a_block_u8[BMP280_LOG_OFFSET_CALIB];
+	bmp280_log_put_u16(&v_out_u8[INDEX_ZERO], calib->dig_T1);
+	bmp280_log_put_u16(&v_out_u8[INDEX_TWO], (u16)calib->dig_T2);
+	bmp280_log_put_u16(&v_out_u8[INDEX_FOUR], (u16)calib->dig_T3);
+	bmp280_log_put_u16(&v_out_u8[INDEX_SIX], calib->dig_P1);
+	bmp280_log_put_u16(&v_out_u8[INDEX_EIGHT], (u16)calib->dig_P2);
+	bmp280_log_put_u16(&v_out_u8[INDEX_TEN], (u16)calib->dig_P3);
+	bmp280_log_put_u16(&v_out_u8[INDEX_TWELVE], (u16)calib->dig_P4);
+	bmp280_log_put_u16(&v_out_u8[INDEX_FOURTEEN], (u16)calib->dig_P5);
+	bmp280_log_put_u16(&v_out_u8[INDEX_SIXTEEN], (u16)calib->dig_P6);
+	bmp280_log_put_u16(&v_out_u8[INDEX_EIGHTEEN], (u16)calib->dig_P7);
+	bmp280_log_put_u16(&v_out_u8[INDEX_TWENTY], (u16)calib->dig_P8);
+	bmp280_log_put_u16(&v_out_u8[INDEX_TWENTY_TWO], (u16)calib->dig_P9);
+	/* second pass: pack the three codes of each sample */
+	v_out_u8 = &a_block_u8[BMP280_LOG_HEADER_LEN];
+	for (v_index_u32 = BMP280_ONE_U8X; v_index_u32 < v_count_u16;
+	v_index_u32++) {
+		for (v_stream_u8 = BMP280_ZERO_U8X;
+		v_stream_u8 < BMP280_LOG_STREAMS; v_stream_u8++) {
+			v_delta_s32 = bmp280_log_delta(a_sample, v_index_u32,
+			v_stream_u8, v_base_delta_u32);
+			v_code_u32 = bmp280_log_zigzag(v_delta_s32 >>
+			a_shift_u8[v_stream_u8]);
+			v_acc_u64 |= (u64)v_code_u32 << v_fill_u8;
+			v_fill_u8 += a_width_u8[v_stream_u8];
+			while (v_fill_u8 >= BMP280_EIGHT_U8X) {
+				*v_out_u8++ = (u8)v_acc_u64;
+				v_acc_u64 >>= BMP280_EIGHT_U8X;
+				v_fill_u8 -= BMP280_EIGHT_U8X;
+			}
+		}
+	}
+	if (v_fill_u8 > BMP280_ZERO_U8X)
+		*v_out_u8++ = (u8)v_acc_u64;
+	while (v_out_u8 < &a_block_u8[BMP280_LOG_HEADER_LEN +
+	v_payload_len_u32])
+		*v_out_u8++ = BMP280_ZERO_U8X;
+	*v_len_u32 = BMP280_LOG_HEADER_LEN + v_payload_len_u32;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API decodes the header of a log block without
+ *	touching its payload
+ *	@note block->payload points into a_block_u8, which has to
+ *	stay valid while the block is decoded.
+ *
+ *
+ *
+ *  @param a_block_u8 : The block
+ *  @param v_len_u32 : Bytes available at a_block_u8
+ *  @param block : The decoded header
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Not a block of this version
+ *	@retval -2 -> Truncated block
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_decode_header(const u8 *a_block_u8,
+u32 v_len_u32, struct bmp280_log_block_t *block)
+{
+	struct bmp280_calib_param_t *calib = BMP280_NULL;
+	const u8 *v_in_u8 = BMP280_NULL;
+	u32 v_bits_u32 = BMP280_ZERO_U8X;
+	u8 v_stream_u8 = BMP280_ZERO_U8X;
+
+	if (a_block_u8 == BMP280_NULL || block == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_len_u32 < BMP280_LOG_HEADER_LEN)
+		return E_BMP280_OUT_OF_RANGE;
+	if (bmp280_frame_get_u32(&a_block_u8[BMP280_LOG_OFFSET_MAGIC]) !=
+	BMP280_LOG_MAGIC ||
+	a_block_u8[BMP280_LOG_OFFSET_VERSION] != BMP280_LOG_VERSION)
+		return ERROR;
+	block->payload_len = bmp280_frame_get_u32(
+	&a_block_u8[BMP280_LOG_OFFSET_PAYLOAD_LEN]);
+	block->count = bmp280_log_get_u16(&a_block_u8[BMP280_LOG_OFFSET_COUNT]);
+	for (v_stream_u8 = BMP280_ZERO_U8X;
+	v_stream_u8 < BMP280_LOG_STREAMS; v_stream_u8++) {
+		block->width[v_stream_u8] =
+		a_block_u8[BMP280_LOG_OFFSET_WIDTH + v_stream_u8];
+		block->shift[v_stream_u8] =
+		a_block_u8[BMP280_LOG_OFFSET_SHIFT + v_stream_u8];
+		if (block->width[v_stream_u8] > BMP280_LOG_MAX_WIDTH ||
+		block->shift[v_stream_u8] > BMP280_LOG_MAX_SHIFT)
+			return ERROR;
+		v_bits_u32 += block->width[v_stream_u8];
+	}
+	if (block->count == BMP280_ZERO_U8X ||
+	v_bits_u32 * (block->count - BMP280_ONE_U8X) >
+	block->payload_len * BMP280_EIGHT_U8X)
+		return ERROR;
+	if (v_len_u32 - BMP280_LOG_HEADER_LEN < block->payload_len)
+		return E_BMP280_OUT_OF_RANGE;
+	block->oversamp_pressure = a_block_u8[BMP280_LOG_OFFSET_OVERSAMP_P];
+	block->oversamp_temperature = a_block_u8[BMP280_LOG_OFFSET_OVERSAMP_T];
+	block->filter = a_block_u8[BMP280_LOG_OFFSET_FILTER];
+	block->first_timestamp_usec = bmp280_frame_get_u32(
+	&a_block_u8[BMP280_LOG_OFFSET_TIMESTAMP]);
+	block->base_delta_usec = bmp280_frame_get_u32(
+	&a_block_u8[BMP280_LOG_OFFSET_BASE_DELTA]);
+	block->first_seq = bmp280_frame_get_u32(
+	&a_block_u8[BMP280_LOG_OFFSET_SEQ]);
+	block->first_pressure = (s32)bmp280_frame_get_u32(
+	&a_block_u8[BMP280_LOG_OFFSET_PRESSURE]);
+	block->first_temperature = (s32)bmp280_frame_get_u32(
+	&a_block_u8[BMP280_LOG_OFFSET_TEMPERATURE]);
+	calib = &block->calib_param;
+	v_in_u8 = &a_block_u8[BMP280_LOG_OFFSET_CALIB];
+	calib->dig_T1 = bmp280_log_get_u16(&v_in_u8[INDEX_ZERO]);
+	calib->dig_T2 = (s16)bmp280_log_get_u16(&v_in_u8[INDEX_TWO]);
+	calib->dig_T3 = (s16)bmp280_log_get_u16(&v_in_u8[INDEX_FOUR]);
+	calib->dig_P1 = bmp280_log_get_u16(&v_in_u8[INDEX_SIX]);
+	calib->dig_P2 = (s16)bmp280_log_get_u16(&v_in_u8[INDEX_EIGHT]);
+	calib->dig_P3 = (s16)bmp280_log_get_u16(&v_in_u8[INDEX_TEN]);
+	calib->dig_P4 = (s16)bmp280_log_get_u16(&v_in_u8[INDEX_TWELVE]);
+	calib->dig_P5 = (s16)bmp280_log_get_u16(&v_in_u8[INDEX_FOURTEEN]);
+	calib->dig_P6 = (s16)bmp280_log_get_u16(&v_in_u8[INDEX_SIXTEEN]);
+	calib->dig_P7 = (s16)bmp280_log_get_u16(&v_in_u8[INDEX_EIGHTEEN]);
+	calib->dig_P8 = (s16)bmp280_log_get_u16(&v_in_u8[INDEX_TWENTY]);
+	calib->dig_P9 = (s16)bmp280_log_get_u16(&v_in_u8[INDEX_TWENTY_TWO]);
+	calib->t_fine = BMP280_ZERO_U8X;
+	block->payload = &a_block_u8[BMP280_LOG_HEADER_LEN];
+	return SUCCESS;
+}
+/* Starts the bit reader at the first sample of a block */
+static void bmp280_log_unpack_init(struct bmp280_log_unpack_t *unpack,
+const struct bmp280_log_block_t *block)
+{
+	u8 v_stream_u8 = BMP280_ZERO_U8X;
+
+	unpack->in = block->payload;
+	unpack->acc = BMP280_ZERO_U8X;
+	unpack->fill = BMP280_ZERO_U8X;
+	unpack->timestamp_usec = block->first_timestamp_usec;
+	unpack->delta_usec = block->base_delta_usec;
+	unpack->pressure = block->first_pressure;
+	unpack->temperature = block->first_temperature;
+	unpack->seq = block->first_seq;
+	unpack->index = BMP280_ZERO_U8X;
+	unpack->count = block->count;
+	for (v_stream_u8 = BMP280_ZERO_U8X;
+	v_stream_u8 < BMP280_LOG_STREAMS; v_stream_u8++) {
+		unpack->width[v_stream_u8] = block->width[v_stream_u8];
+		unpack->shift[v_stream_u8] = block->shift[v_stream_u8];
+		unpack->mask[v_stream_u8] = ((u64)BMP280_ONE_U8X <<
+		block->width[v_stream_u8]) - BMP280_ONE_U8X;
+	}
+}
+/* Next delta of one stream */
+static s32 bmp280_log_unpack(struct bmp280_log_unpack_t *unpack,
+u8 v_stream_u8)
+{
+	u32 v_code_u32 = BMP280_ZERO_U8X;
+	u8 v_width_u8 = unpack->width[v_stream_u8];
+
+	while (unpack->fill < v_width_u8) {
+		unpack->acc |= (u64)*unpack->in++ << unpack->fill;
+		unpack->fill += BMP280_EIGHT_U8X;
+	}
+	v_code_u32 = (u32)(unpack->acc & unpack->mask[v_stream_u8]);
+	unpack->acc >>= v_width_u8;
+	unpack->fill -= v_width_u8;
+	return (s32)((u32)bmp280_log_unzigzag(v_code_u32) <<
+	unpack->shift[v_stream_u8]);
+}
+/* Decodes up to v_max_u32 further samples of the block; the running
+ * values are kept in locals so that stores to a_sample cannot force
+ * them back to memory */
+static u32 bmp280_log_unpack_samples(struct bmp280_log_unpack_t *unpack,
+struct bmp280_sample_t *a_sample, u32 v_max_u32)
+{
+	u32 v_timestamp_u32 = unpack->timestamp_usec;
+	u32 v_delta_u32 = unpack->delta_usec;
+	s32 v_pressure_s32 = unpack->pressure;
+	s32 v_temperature_s32 = unpack->temperature;
+	u32 v_count_u32 = (u32)(unpack->count - unpack->index);
+	u32 v_index_u32 = BMP280_ZERO_U8X;
+
+	if (v_count_u32 > v_max_u32)
+		v_count_u32 = v_max_u32;
+	for (v_index_u32 = BMP280_ZERO_U8X; v_index_u32 < v_count_u32;
+	v_index_u32++) {
+		if (unpack->index + v_index_u32 > BMP280_ZERO_U8X) {
+			v_delta_u32 += (u32)bmp280_log_unpack(unpack,
+			BMP280_LOG_STREAM_TIME);
+			v_timestamp_u32 += v_delta_u32;
+			v_pressure_s32 += bmp280_log_unpack(unpack,
+			BMP280_LOG_STREAM_PRESSURE);
+			v_temperature_s32 += bmp280_log_unpack(unpack,
+			BMP280_LOG_STREAM_TEMPERATURE);
+		}
+		a_sample[v_index_u32].uncomp_pressure = v_pressure_s32;
+		a_sample[v_index_u32].uncomp_temperature = v_temperature_s32;
+		a_sample[v_index_u32].pressure = BMP280_ZERO_U8X;
+		a_sample[v_index_u32].temperature = BMP280_ZERO_U8X;
+		a_sample[v_index_u32].timestamp_usec = v_timestamp_u32;
+		a_sample[v_index_u32].seq = unpack->seq + v_index_u32;
+		a_sample[v_index_u32].status = BMP280_ZERO_U8X;
+	}
+	unpack->timestamp_usec = v_timestamp_u32;
+	unpack->delta_usec = v_delta_u32;
+	unpack->pressure = v_pressure_s32;
+	unpack->temperature = v_temperature_s32;
+	unpack->seq += v_count_u32;
+	unpack->index += (u16)v_count_u32;
+	return v_count_u32;
+}
+/*!
+ *	@brief This API decodes the samples of a log block
+ *	@note The raw codes, timestamps and sequence numbers are
+ *	restored, the sequence counting up from the first sample; the
+ *	compensated fields and status are zero. Compensate with
+ *	bmp280_compensate_samples(&block->calib_param, ...).
+ *
+ *
+ *
+ *  @param block : Header decoded by bmp280_log_decode_header()
+ *  @param a_sample : Destination for block->count samples
+ *  @param v_max_u32 : Size of the destination
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Destination too small
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_decode_block(
+const struct bmp280_log_block_t *block, struct bmp280_sample_t *a_sample,
+u32 v_max_u32)
+{
+	struct bmp280_log_unpack_t unpack;
+
+	if (block == BMP280_NULL || a_sample == BMP280_NULL ||
+	block->payload == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_max_u32 < block->count)
+		return E_BMP280_OUT_OF_RANGE;
+	bmp280_log_unpack_init(&unpack, block);
+	bmp280_log_unpack_samples(&unpack, a_sample, block->count);
+	return SUCCESS;
+}
+/*!
+ *	@brief This API sets up a log writer collecting the samples
+ *	of dev into blocks of v_capacity_u16 samples
+ *
+ *
+ *
+ *  @param writer : The writer
+ *  @param dev : Device of the samples; its calibration and
+ *	configuration go into every block
+ *  @param a_sample : Storage for v_capacity_u16 samples
+ *  @param v_capacity_u16 : Samples per block
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Zero capacity
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_writer_init(
+struct bmp280_log_writer_t *writer, const struct bmp280_t *dev,
+struct bmp280_sample_t *a_sample, u16 v_capacity_u16)
+{
+	if (writer == BMP280_NULL || dev == BMP280_NULL ||
+	a_sample == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	if (v_capacity_u16 == BMP280_ZERO_U8X)
+		return E_BMP280_OUT_OF_RANGE;
+	writer->dev = dev;
+	writer->sample = a_sample;
+	writer->count = BMP280_ZERO_U8X;
+	writer->capacity = v_capacity_u16;
+	writer->block_count = BMP280_ZERO_U8X;
+	writer->offset = BMP280_ZERO_U8X;
+	writer->time_usec = BMP280_ZERO_U8X;
+	writer->block_time_usec = BMP280_ZERO_U8X;
+	writer->timestamp_usec = BMP280_ZERO_U8X;
+	writer->index.count = BMP280_ZERO_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API closes the open block of a writer, if it
+ *	holds any sample, e.g. before shutdown or a calibration change
+ *
+ *
+ *
+ *  @param writer : The writer
+ *  @param a_block_u8 : Destination of bmp280_log_block_bound()
+ *	bytes for the writer capacity
+ *  @param v_size_u32 : Size of the destination
+ *  @param v_len_u32 : Size of the block to append, 0 if none;
+ *	writer->index then holds its index entry
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Destination too small
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_writer_flush(
+struct bmp280_log_writer_t *writer, u8 *a_block_u8, u32 v_size_u32,
+u32 *v_len_u32)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	struct bmp280_log_index_t *index = BMP280_NULL;
+	const struct bmp280_sample_t *sample = BMP280_NULL;
+	u16 v_index_u16 = BMP280_ZERO_U8X;
+
+	if (writer == BMP280_NULL || v_len_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	*v_len_u32 = BMP280_ZERO_U8X;
+	if (writer->count == BMP280_ZERO_U8X)
+		return SUCCESS;
+	com_rslt = bmp280_log_encode_block(writer->dev, writer->sample,
+	writer->count, a_block_u8, v_size_u32, v_len_u32);
+	if (com_rslt == SUCCESS) {
+		index = &writer->index;
+		index->offset = writer->offset;
+		index->first_time_usec = writer->block_time_usec;
+		index->last_time_usec = writer->time_usec;
+		index->min_pressure =
+		writer->sample[INDEX_ZERO].uncomp_pressure;
+		index->max_pressure = index->min_pressure;
+		index->min_temperature =
+		writer->sample[INDEX_ZERO].uncomp_temperature;
+		index->max_temperature = index->min_temperature;
+		for (v_index_u16 = BMP280_ONE_U8X; v_index_u16 < writer->count;
+		v_index_u16++) {
+			sample = &writer->sample[v_index_u16];
+			if (sample->uncomp_pressure < index->min_pressure)
+				index->min_pressure = sample->uncomp_pressure;
+			if (sample->uncomp_pressure > index->max_pressure)
+				index->max_pressure = sample->uncomp_pressure;
+			if (sample->uncomp_temperature < index->min_temperature)
+				index->min_temperature =
+				sample->uncomp_temperature;
+			if (sample->uncomp_temperature > index->max_temperature)
+				index->max_temperature =
+				sample->uncomp_temperature;
+		}
+		index->count = writer->count;
+		writer->offset += *v_len_u32;
+		writer->count = BMP280_ZERO_U8X;
+		writer->block_count++;
+	}
+	return com_rslt;
+}
+/*!
+ *	@brief This API adds a sample to the open block of a writer;
+ *	a full block is encoded into a_block_u8
+ *
+ *
+ *
+ *  @param writer : The writer
+ *  @param sample : The sample
+ *  @param a_block_u8 : Destination of bmp280_log_block_bound()
+ *	bytes for the writer capacity
+ *  @param v_size_u32 : Size of the destination
+ *  @param v_len_u32 : Size of the block to append, 0 if none;
+ *	writer->index then holds its index entry
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Destination too small
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_writer_push(
+struct bmp280_log_writer_t *writer, const struct bmp280_sample_t *sample,
+u8 *a_block_u8, u32 v_size_u32, u32 *v_len_u32)
+{
+	if (writer == BMP280_NULL || sample == BMP280_NULL ||
+	v_len_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	*v_len_u32 = BMP280_ZERO_U8X;
+	/* a block that could not be written stays full */
+	if (writer->count >= writer->capacity)
+		return E_BMP280_OUT_OF_RANGE;
+	/* the first sample keeps the preset time */
+	if (writer->block_count != BMP280_ZERO_U8X ||
+	writer->count != BMP280_ZERO_U8X)
+		writer->time_usec += (u32)(sample->timestamp_usec -
+		writer->timestamp_usec);
+	writer->timestamp_usec = sample->timestamp_usec;
+	if (writer->count == BMP280_ZERO_U8X)
+		writer->block_time_usec = writer->time_usec;
+	writer->sample[writer->count++] = *sample;
+	if (writer->count < writer->capacity)
+		return SUCCESS;
+	return bmp280_log_writer_flush(writer, a_block_u8, v_size_u32,
+	v_len_u32);
+}
+/*!
+ *	@brief This API writes an index entry in its little endian
+ *	form of BMP280_LOG_INDEX_LEN bytes
+ *
+ *
+ *
+ *  @param index : The index entry
+ *  @param a_data_u8 : Destination of BMP280_LOG_INDEX_LEN bytes
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_index_put(
+const struct bmp280_log_index_t *index, u8 *a_data_u8)
+{
+	u8 v_index_u8 = BMP280_ZERO_U8X;
+
+	if (index == BMP280_NULL || a_data_u8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	for (v_index_u8 = BMP280_ZERO_U8X; v_index_u8 < BMP280_LOG_INDEX_LEN;
+	v_index_u8++)
+		a_data_u8[v_index_u8] = BMP280_ZERO_U8X;
+	bmp280_log_put_u64(&a_data_u8[BMP280_LOG_INDEX_OFFSET], index->offset);
+	bmp280_log_put_u64(&a_data_u8[BMP280_LOG_INDEX_FIRST_TIME],
+	index->first_time_usec);
+	bmp280_log_put_u64(&a_data_u8[BMP280_LOG_INDEX_LAST_TIME],
+	index->last_time_usec);
+	bmp280_frame_put_u32(&a_data_u8[BMP280_LOG_INDEX_MIN_PRESSURE],
+	(u32)index->min_pressure);
+	bmp280_frame_put_u32(&a_data_u8[BMP280_LOG_INDEX_MAX_PRESSURE],
+	(u32)index->max_pressure);
+	bmp280_frame_put_u32(&a_data_u8[BMP280_LOG_INDEX_MIN_TEMPERATURE],
+	(u32)index->min_temperature);
+	bmp280_frame_put_u32(&a_data_u8[BMP280_LOG_INDEX_MAX_TEMPERATURE],
+	(u32)index->max_temperature);
+	bmp280_frame_put_u32(&a_data_u8[BMP280_LOG_INDEX_COUNT], index->count);
+	return SUCCESS;
+}
+/*!
+ *	@brief This API reads an index entry written by
+ *	bmp280_log_index_put()
+ *
+ *
+ *
+ *  @param a_data_u8 : BMP280_LOG_INDEX_LEN bytes
+ *  @param index : The index entry
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Not an index entry
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_index_get(const u8 *a_data_u8,
+struct bmp280_log_index_t *index)
+{
+	if (a_data_u8 == BMP280_NULL || index == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	index->offset = bmp280_log_get_u64(&a_data_u8[BMP280_LOG_INDEX_OFFSET]);
+	index->first_time_usec = bmp280_log_get_u64(
+	&a_data_u8[BMP280_LOG_INDEX_FIRST_TIME]);
+	index->last_time_usec = bmp280_log_get_u64(
+	&a_data_u8[BMP280_LOG_INDEX_LAST_TIME]);
+	index->min_pressure = (s32)bmp280_frame_get_u32(
+	&a_data_u8[BMP280_LOG_INDEX_MIN_PRESSURE]);
+	index->max_pressure = (s32)bmp280_frame_get_u32(
+	&a_data_u8[BMP280_LOG_INDEX_MAX_PRESSURE]);
+	index->min_temperature = (s32)bmp280_frame_get_u32(
+	&a_data_u8[BMP280_LOG_INDEX_MIN_TEMPERATURE]);
+	index->max_temperature = (s32)bmp280_frame_get_u32(
+	&a_data_u8[BMP280_LOG_INDEX_MAX_TEMPERATURE]);
+	index->count = bmp280_frame_get_u32(&a_data_u8[BMP280_LOG_INDEX_COUNT]);
+	if (index->count == BMP280_ZERO_U8X ||
+	index->count > BMP280_LOG_MAX_SAMPLES ||
+	index->last_time_usec < index->first_time_usec ||
+	index->max_pressure < index->min_pressure ||
+	index->max_temperature < index->min_temperature)
+		return ERROR;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API sets up a query matching every sample: all
+ *	time and value ranges open, all counters zero
+ *	@note Narrow the ranges afterwards. The physical ranges alone
+ *	already skip blocks when bmp280_log_query_index() gets the
+ *	calibration; the raw ranges are only needed to narrow a query
+ *	on the raw codes themselves.
+ *
+ *
+ *
+ *  @param query : The query
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_query_init(
+struct bmp280_log_query_t *query)
+{
+	if (query == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	query->from_time_usec = BMP280_ZERO_U8X;
+	query->to_time_usec = ~(u64)BMP280_ZERO_U8X;
+	query->min_uncomp_pressure = BMP280_ZERO_U8X;
+	query->max_uncomp_pressure = BMP280_LOG_QUERY_MAX_UNCOMP;
+	query->min_uncomp_temperature = BMP280_ZERO_U8X;
+	query->max_uncomp_temperature = BMP280_LOG_QUERY_MAX_UNCOMP;
+	query->min_pressure = BMP280_ZERO_U8X;
+	query->max_pressure = ~(u32)BMP280_ZERO_U8X;
+	query->min_temperature = BMP280_LOG_QUERY_MIN_TEMPERATURE;
+	query->max_temperature = BMP280_LOG_QUERY_MAX_TEMPERATURE;
+	query->block_count = BMP280_ZERO_U8X;
+	query->block_skip_count = BMP280_ZERO_U8X;
+	query->compensated_count = BMP280_ZERO_U8X;
+	query->match_count = BMP280_ZERO_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API checks an index entry against the time and
+ *	raw ranges of a query, without touching the block
+ *	@note With the calibration the physical ranges are checked as
+ *	well: the temperature range of the block follows exactly from
+ *	its raw range, and its raw pressure range is compared with the
+ *	raw bounds of the pressure range from bmp280_invert_pressure()
+ *	at the t_fine of both temperature extremes.
+ *
+ *
+ *
+ *  @param query : The query
+ *  @param index : Index entry of the block
+ *  @param calib : Calibration of the device of the log, or
+ *	BMP280_NULL to check the time and raw ranges only
+ *  @param v_match_u8 : 1 if the block may hold a match, 0 if it
+ *	can be skipped
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_query_index(
+struct bmp280_log_query_t *query, const struct bmp280_log_index_t *index,
+const struct bmp280_calib_param_t *calib, u8 *v_match_u8)
+{
+	/* t_fine of the bounds lives in this private copy */
+	struct bmp280_calib_param_t calib_local;
+	s32 a_t_fine_s32[ARRAY_SIZE_TWO] = {BMP280_ZERO_U8X, BMP280_ZERO_U8X};
+	s32 v_code_s32 = BMP280_ZERO_U8X;
+	/* raw pressure codes that may match, over both t_fine */
+	s32 v_low_s32 = BMP280_UNCOMP_CODE_COUNT;
+	s32 v_high_s32 = -BMP280_ONE_U8X;
+	u8 v_index_u8 = BMP280_ZERO_U8X;
+
+	if (query == BMP280_NULL || index == BMP280_NULL ||
+	v_match_u8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	query->block_count++;
+	*v_match_u8 = (index->last_time_usec >= query->from_time_usec &&
+	index->first_time_usec <= query->to_time_usec &&
+	index->max_pressure >= query->min_uncomp_pressure &&
+	index->min_pressure <= query->max_uncomp_pressure &&
+	index->max_temperature >= query->min_uncomp_temperature &&
+	index->min_temperature <= query->max_uncomp_temperature);
+	if (*v_match_u8 && calib != BMP280_NULL) {
+		/* the temperature rises with its raw code */
+		calib_local = *calib;
+		if (bmp280_calib_compensate_T_int32(&calib_local,
+		index->min_temperature) > query->max_temperature)
+			*v_match_u8 = BMP280_ZERO_U8X;
+		a_t_fine_s32[INDEX_ZERO] = calib_local.t_fine;
+		if (bmp280_calib_compensate_T_int32(&calib_local,
+		index->max_temperature) < query->min_temperature)
+			*v_match_u8 = BMP280_ZERO_U8X;
+		a_t_fine_s32[INDEX_ONE] = calib_local.t_fine;
+	}
+	if (*v_match_u8 && calib != BMP280_NULL &&
+	(query->min_pressure > BMP280_ZERO_U8X ||
+	query->max_pressure < ~(u32)BMP280_ZERO_U8X)) {
+		/* the pressure falls as its raw code rises: codes up to
+		the inverse of min_pressure reach it, codes above the
+		inverse of max_pressure + 1 stay within it */
+		for (v_index_u8 = INDEX_ZERO; v_index_u8 < ARRAY_SIZE_TWO;
+		v_index_u8++) {
+			bmp280_invert_pressure(calib, a_t_fine_s32[v_index_u8],
+			query->min_pressure, &v_code_s32);
+			if (v_code_s32 > v_high_s32)
+				v_high_s32 = v_code_s32;
+			v_code_s32 = -BMP280_ONE_U8X;
+			if (query->max_pressure < ~(u32)BMP280_ZERO_U8X)
+				bmp280_invert_pressure(calib,
+				a_t_fine_s32[v_index_u8],
+				query->max_pressure + BMP280_ONE_U8X,
+				&v_code_s32);
+			if (v_code_s32 + BMP280_ONE_U8X < v_low_s32)
+				v_low_s32 = v_code_s32 + BMP280_ONE_U8X;
+		}
+		*v_match_u8 = (index->min_pressure <= v_high_s32 &&
+		index->max_pressure >= v_low_s32);
+	}
+	if (!*v_match_u8)
+		query->block_skip_count++;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API returns the samples of a block that match a
+ *	query, compensated
+ *	@note Samples are filtered on time and raw codes first; only
+ *	those left are compensated and filtered on the physical ranges.
+ *	The matches are packed to the start of a_sample.
+ *
+ *
+ *
+ *  @param query : The query
+ *  @param index : Index entry of the block
+ *  @param block : Header decoded by bmp280_log_decode_header()
+ *  @param a_sample : Storage for block->count samples
+ *  @param v_max_u32 : Size of the storage
+ *  @param v_count_u32 : Number of matching samples
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Index entry does not describe the block
+ *	@retval -2 -> Storage too small
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_query_block(
+struct bmp280_log_query_t *query, const struct bmp280_log_index_t *index,
+const struct bmp280_log_block_t *block, struct bmp280_sample_t *a_sample,
+u32 v_max_u32, u32 *v_count_u32)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	const struct bmp280_sample_t *sample = BMP280_NULL;
+	u64 v_time_u64 = BMP280_ZERO_U8X;
+	u32 v_timestamp_u32 = BMP280_ZERO_U8X;
+	u32 v_index_u32 = BMP280_ZERO_U8X;
+	u32 v_keep_u32 = BMP280_ZERO_U8X;
+
+	if (query == BMP280_NULL || index == BMP280_NULL ||
+	v_count_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	*v_count_u32 = BMP280_ZERO_U8X;
+	com_rslt = bmp280_log_decode_block(block, a_sample, v_max_u32);
+	if (com_rslt != SUCCESS)
+		return com_rslt;
+	if (index->count != block->count)
+		return ERROR;
+	/* raw pass: time and raw codes; the time adds up the deltas
+	 * in 64 bits as the writer does, a block may span more than
+	 * the 32 bit timestamp range */
+	v_time_u64 = index->first_time_usec;
+	v_timestamp_u32 = block->first_timestamp_usec;
+	for (v_index_u32 = BMP280_ZERO_U8X; v_index_u32 < block->count;
+	v_index_u32++) {
+		sample = &a_sample[v_index_u32];
+		v_time_u64 += (u32)(sample->timestamp_usec - v_timestamp_u32);
+		v_timestamp_u32 = sample->timestamp_usec;
+		if (v_time_u64 < query->from_time_usec ||
+		v_time_u64 > query->to_time_usec ||
+		sample->uncomp_pressure < query->min_uncomp_pressure ||
+		sample->uncomp_pressure > query->max_uncomp_pressure ||
+		sample->uncomp_temperature < query->min_uncomp_temperature ||
+		sample->uncomp_temperature > query->max_uncomp_temperature)
+			continue;
+		a_sample[v_keep_u32++] = *sample;
+	}
+	com_rslt = bmp280_compensate_samples(&block->calib_param, a_sample,
+	v_keep_u32);
+	query->compensated_count += v_keep_u32;
+	/* physical pass on the survivors */
+	for (v_index_u32 = BMP280_ZERO_U8X; v_index_u32 < v_keep_u32;
+	v_index_u32++) {
+		sample = &a_sample[v_index_u32];
+		if (sample->pressure < query->min_pressure ||
+		sample->pressure > query->max_pressure ||
+		sample->temperature < query->min_temperature ||
+		sample->temperature > query->max_temperature)
+			continue;
+		a_sample[(*v_count_u32)++] = *sample;
+	}
+	query->match_count += *v_count_u32;
+	return com_rslt;
+}
+/*!
+ *	@brief This API sets up a cursor over a log held in memory,
+ *	e.g. a file mapped with mmap()
+ *	@note Nothing is copied: the log has to stay mapped while the
+ *	cursor and the blocks it returns are in use.
+ *
+ *
+ *
+ *  @param cursor : The cursor
+ *  @param a_data_u8 : Start of the log
+ *  @param v_len_u64 : Bytes of the log
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_cursor_init(
+struct bmp280_log_cursor_t *cursor, const u8 *a_data_u8, u64 v_len_u64)
+{
+	if (cursor == BMP280_NULL || a_data_u8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	cursor->data = a_data_u8;
+	cursor->len = v_len_u64;
+	cursor->offset = BMP280_ZERO_U8X;
+	cursor->block.count = BMP280_ZERO_U8X;
+	cursor->block.payload = BMP280_NULL;
+	cursor->unpack.index = BMP280_ZERO_U8X;
+	cursor->unpack.count = BMP280_ZERO_U8X;
+	cursor->block_count = BMP280_ZERO_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API moves a cursor to the next block; only its
+ *	header is read, the samples left in the current block are
+ *	skipped without being decoded
+ *	@note cursor->block then describes the block in place.
+ *	A block cut short at the end of the log, e.g. of a file still
+ *	being written, is reported as -2; the cursor stays before it,
+ *	so the call can be repeated once the log has grown.
+ *
+ *
+ *
+ *  @param cursor : The cursor
+ *  @param v_valid_u8 : 1 if a block was entered, 0 at the end
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Not a block of this version
+ *	@retval -2 -> Truncated block
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_cursor_next_block(
+struct bmp280_log_cursor_t *cursor, u8 *v_valid_u8)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = ERROR;
+	u64 v_left_u64 = BMP280_ZERO_U8X;
+
+	if (cursor == BMP280_NULL || v_valid_u8 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	*v_valid_u8 = BMP280_ZERO_U8X;
+	if (cursor->offset >= cursor->len)
+		return SUCCESS;
+	v_left_u64 = cursor->len - cursor->offset;
+	com_rslt = bmp280_log_decode_header(&cursor->data[cursor->offset],
+	v_left_u64 > (u32)~BMP280_ZERO_U8X ? (u32)~BMP280_ZERO_U8X :
+	(u32)v_left_u64, &cursor->block);
+	if (com_rslt != SUCCESS) {
+		cursor->unpack.index = cursor->unpack.count;
+		return com_rslt;
+	}
+	cursor->offset += BMP280_LOG_HEADER_LEN + cursor->block.payload_len;
+	bmp280_log_unpack_init(&cursor->unpack, &cursor->block);
+	cursor->block_count++;
+	*v_valid_u8 = BMP280_ONE_U8X;
+	return SUCCESS;
+}
+/*!
+ *	@brief This API decodes the next samples of the current block
+ *	of a cursor, raw as in bmp280_log_decode_block()
+ *
+ *
+ *
+ *  @param cursor : The cursor
+ *  @param a_sample : Destination
+ *  @param v_max_u32 : Size of the destination
+ *  @param v_count_u32 : Samples decoded, 0 at the end of the block
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_cursor_read(
+struct bmp280_log_cursor_t *cursor, struct bmp280_sample_t *a_sample,
+u32 v_max_u32, u32 *v_count_u32)
+{
+	if (cursor == BMP280_NULL || a_sample == BMP280_NULL ||
+	v_count_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	*v_count_u32 = bmp280_log_unpack_samples(&cursor->unpack, a_sample,
+	v_max_u32);
+	return SUCCESS;
+}
+/*!
+ *	@brief This API fills a_sample with the next compensated
+ *	samples of a log, crossing blocks as needed
+ *	@note Each block's samples are compensated as one batch by
+ *	bmp280_compensate_samples() with the calibration stored in
+ *	that block.
+ *
+ *
+ *
+ *  @param cursor : The cursor
+ *  @param a_sample : Destination
+ *  @param v_max_u32 : Size of the destination
+ *  @param v_count_u32 : Samples returned, 0 at the end of the log
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success, v_count_u32 samples returned
+ *	@retval -1 -> Not a block of this version
+ *	@retval -2 -> Truncated block after the samples returned
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_cursor_next(
+struct bmp280_log_cursor_t *cursor, struct bmp280_sample_t *a_sample,
+u32 v_max_u32, u32 *v_count_u32)
+{
+	/* variable used to return communication result*/
+	BMP280_RETURN_FUNCTION_TYPE com_rslt = SUCCESS;
+	u32 v_read_u32 = BMP280_ZERO_U8X;
+	u8 v_valid_u8 = BMP280_ONE_U8X;
+
+	if (cursor == BMP280_NULL || a_sample == BMP280_NULL ||
+	v_count_u32 == BMP280_NULL)
+		return E_BMP280_NULL_PTR;
+	*v_count_u32 = BMP280_ZERO_U8X;
+	while (*v_count_u32 < v_max_u32) {
+		if (cursor->unpack.index == cursor->unpack.count) {
+			com_rslt = bmp280_log_cursor_next_block(cursor,
+			&v_valid_u8);
+			if (com_rslt != SUCCESS || !v_valid_u8)
+				break;
+		}
+		v_read_u32 = bmp280_log_unpack_samples(&cursor->unpack,
+		&a_sample[*v_count_u32], v_max_u32 - *v_count_u32);
+		bmp280_compensate_samples(&cursor->block.calib_param,
+		&a_sample[*v_count_u32], v_read_u32);
+		*v_count_u32 += v_read_u32;
+	}
+	return com_rslt;
+}
+#endif
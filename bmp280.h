@@ -445,9 +445,13 @@ BMP280_BUS_RD_PARAM_TYPE to function calls used inside the API
 #define SHIFT_RIGHT_13_POSITION				 13
 #define SHIFT_RIGHT_14_POSITION				 14
 #define SHIFT_RIGHT_15_POSITION				 15
+#define SHIFT_RIGHT_16_POSITION				 16
 #define SHIFT_RIGHT_18_POSITION				 18
 #define SHIFT_RIGHT_19_POSITION				 19
+#define SHIFT_RIGHT_20_POSITION				 20
 #define SHIFT_RIGHT_25_POSITION				 25
+#define SHIFT_RIGHT_31_POSITION				 31
+#define SHIFT_RIGHT_32_POSITION				 32
 #define SHIFT_RIGHT_33_POSITION				 33
 /* left shift definitions*/
 #define SHIFT_LEFT_1_POSITION                1
@@ -458,12 +462,16 @@ BMP280_BUS_RD_PARAM_TYPE to function calls used inside the API
 #define SHIFT_LEFT_12_POSITION               12
 #define SHIFT_LEFT_16_POSITION               16
 #define SHIFT_LEFT_17_POSITION               17
+#define SHIFT_LEFT_20_POSITION               20
+#define SHIFT_LEFT_24_POSITION               24
 #define SHIFT_LEFT_31_POSITION               31
+#define SHIFT_LEFT_32_POSITION               32
 #define SHIFT_LEFT_35_POSITION               35
 #define SHIFT_LEFT_47_POSITION               47
 /* numeric definitions*/
 #define BMP280_ZERO_U8X                      0
 #define BMP280_ONE_U8X                       1
+#define BMP280_TWO_U8X                       2
 #define BMP280_THREE_U8X                     3
 #define BMP280_FOUR_U8X                      4
 #define BMP280_SIX_U8X                       6
@@ -553,6 +561,220 @@ BMP280_BUS_RD_PARAM_TYPE to function calls used inside the API
 /* 37/16 = 2.3125 ms*/
 #define T_SETUP_PRESSURE_MAX				10
 /* 10/16 = 0.625 ms */
+#define T_UNIT_USEC_NUMERATOR				125
+#define T_UNIT_USEC_DENOMINATOR				2
+/* one 1/16 ms timing unit = 125/2 us */
+#define BMP280_USEC_PER_MSEC				1000
+#define BMP280_USEC_PER_SEC				1000000
+/************************************************/
+/**\name	TIMESTAMP HANDLING       */
+/***********************************************/
+/* signed difference of two wrapping u32 microsecond timestamps */
+#define BMP280_TIME_DIFF_USEC(v_a_u32, v_b_u32)\
+	((s32)((u32)(v_a_u32) - (u32)(v_b_u32)))
+/************************************************/
+/**\name	MEMORY ORDERING FOR LOCK-FREE BUFFERS       */
+/***********************************************/
+/*!
+* @brief Full memory barrier used between the producer and the consumer
+* of the lock-free buffers. Define it before including this file
+* if your platform needs a different barrier.
+*/
+#ifndef BMP280_MEMORY_BARRIER
+#if defined(__KERNEL__)
+#define BMP280_MEMORY_BARRIER() smp_mb()
+#elif defined(__GNUC__)
+#define BMP280_MEMORY_BARRIER() __sync_synchronize()
+#else
+#warning Please define BMP280_MEMORY_BARRIER for your platform
+#define BMP280_MEMORY_BARRIER()
+#endif
+#endif
+/*!
+* @brief Size of a cache line, used to keep producer and
+* consumer indices on separate lines
+*/
+#ifndef BMP280_CACHE_LINE_SIZE
+#define BMP280_CACHE_LINE_SIZE               64
+#endif
+/************************************************/
+/**\name	ACQUISITION ENGINE DEFINITION       */
+/***********************************************/
+#define BMP280_ASYNC_STATE_IDLE              0
+#define BMP280_ASYNC_STATE_CONVERTING        1
+#define BMP280_ENGINE_INDEX_NONE             0xFFFF
+#define BMP280_ENGINE_MEAN_WINDOW            64
+/* lateness taken into the mean, keeps its fixed point in s32 */
+#define BMP280_ENGINE_MEAN_MAX_LATE_USEC     0x00FFFFFF
+/************************************************/
+/**\name	STREAM READER DEFINITION       */
+/***********************************************/
+#define BMP280_STREAM_DATA_LEN               10
+/* status, ctrl_meas, config, reserved and six data bytes */
+#define BMP280_STREAM_GUARD_DIVIDER          32
+#define BMP280_STREAM_GUARD_MIN_USEC         100
+#define BMP280_STREAM_PROBE_INTERVAL         16
+#define BMP280_STREAM_PERIOD_GAIN_SHIFT      2
+/************************************************/
+/**\name	BUS ARBITRATION DEFINITION       */
+/***********************************************/
+#define BMP280_XFER_WRITE                    0
+#define BMP280_XFER_READ                     1
+#define BMP280_XFER_WAIT                     2
+#define BMP280_TXN_MAX_STEPS                 4
+#define BMP280_TXN_DATA_LEN                  8
+/* ctrl_meas byte followed by the six data bytes */
+#define BMP280_TXN_FORCED_DATA_INDEX         1
+/************************************************/
+/**\name	INVERSE COMPENSATION DEFINITION       */
+/***********************************************/
+/* number of 20 bit ADC codes */
+#define BMP280_UNCOMP_CODE_COUNT             0x100000
+/************************************************/
+/**\name	RAW DOMAIN TRIGGER DEFINITION       */
+/***********************************************/
+#define BMP280_CHANNEL_PRESSURE              0
+#define BMP280_CHANNEL_TEMPERATURE           1
+/* fires when the value rises above level */
+#define BMP280_TRIGGER_ABOVE                 0
+/* fires when the value falls below level */
+#define BMP280_TRIGGER_BELOW                 1
+/* fires when the value changes faster than rate per second */
+#define BMP280_TRIGGER_RATE                  2
+/* raw codes used to measure the local slope of a channel */
+#define BMP280_TRIGGER_SLOPE_SPAN            4096
+/************************************************/
+/**\name	DELTA PUBLISH DEFINITION       */
+/***********************************************/
+#define BMP280_PUBLISH_NONE                  0
+#define BMP280_PUBLISH_SAMPLE                1
+#define BMP280_PUBLISH_HEARTBEAT             2
+/************************************************/
+/**\name	SOFTWARE IIR DEFINITION       */
+/***********************************************/
+/* fractional bits of the filter state, above the largest shift */
+#define BMP280_IIR_FRAC_BITS                 8
+/************************************************/
+/**\name	DECIMATION DEFINITION       */
+/***********************************************/
+/* highest CIC order, order 1 is a boxcar average */
+#define BMP280_DECIM_MAX_ORDER               3
+/* ratio^order, keeps the sums of 20 bit codes within 32 bits */
+#define BMP280_DECIM_MAX_GAIN                4096
+/* stages served by bmp280_decim_push_all, one bit each */
+#define BMP280_DECIM_MAX_STAGES              32
+/* resolution of a conversion at osrs x1 and of the 20 bit data word */
+#define BMP280_RESOLUTION_X1_BITS            16
+#define BMP280_RESOLUTION_MAX_BITS           20
+/************************************************/
+/**\name	LATEST SAMPLE TABLE DEFINITION       */
+/***********************************************/
+/* slots of a table, with its header the table fills 4 KiB */
+#define BMP280_LATEST_MAX_SENSORS            63
+/* "BP28", written last by bmp280_latest_table_init */
+#define BMP280_LATEST_MAGIC                  0x42503238
+/* attempts of a reader before it reports a busy slot */
+#define BMP280_LATEST_READ_RETRY             8
+/************************************************/
+/**\name	SAMPLE FRAME DEFINITION       */
+/***********************************************/
+/* type, sensor and little endian payload length */
+#define BMP280_FRAME_HEADER_LEN              4
+/* two 20 bit raw codes in 5 bytes, pressure, temperature,
+timestamp, sequence and status */
+#define BMP280_FRAME_SAMPLE_LEN              22
+/* field offsets in a packed sample, the raw codes are at 0 */
+#define BMP280_FRAME_SAMPLE_PRESSURE         5
+#define BMP280_FRAME_SAMPLE_TEMPERATURE      9
+#define BMP280_FRAME_SAMPLE_TIMESTAMP        13
+#define BMP280_FRAME_SAMPLE_SEQ              17
+#define BMP280_FRAME_SAMPLE_STATUS           21
+/* period in us, batch size and flags */
+#define BMP280_FRAME_SUBSCRIBE_LEN           6
+/* capacity of the ring in samples */
+#define BMP280_FRAME_SHM_RING_LEN            4
+/* result of a request, a signed return code */
+#define BMP280_FRAME_STATUS_LEN              1
+#define BMP280_FRAME_MAX_PAYLOAD             0xFFFF
+/* frame types */
+#define BMP280_FRAME_SUBSCRIBE               1
+#define BMP280_FRAME_UNSUBSCRIBE             2
+#define BMP280_FRAME_SAMPLES                 3
+#define BMP280_FRAME_SHM_RING                4
+#define BMP280_FRAME_STATUS                  5
+/* subscribe flag: deliver through a shared memory ring */
+#define BMP280_FRAME_FLAG_SHM                0x01
+/************************************************/
+/**\name	SHARED MEMORY RING DEFINITION       */
+/***********************************************/
+/* "BPR1", written last by bmp280_shm_ring_init */
+#define BMP280_SHM_RING_MAGIC                0x42505231
+/* the samples follow the ring header in the same mapping */
+#define BMP280_SHM_RING_SLOT(ring)\
+	((struct bmp280_sample_t *)((struct bmp280_shm_ring_t *)(ring) + 1))
+/************************************************/
+/**\name	SAMPLE LOG DEFINITION       */
+/***********************************************/
+/* "BPL1" at the start of every block */
+#define BMP280_LOG_MAGIC                     0x314C5042
+#define BMP280_LOG_VERSION                   1
+/* blocks and payloads are padded to this size */
+#define BMP280_LOG_ALIGN                     8
+#define BMP280_LOG_MAX_SAMPLES               0xFFFF
+/* delta streams of a block */
+#define BMP280_LOG_STREAM_TIME               0
+#define BMP280_LOG_STREAM_PRESSURE           1
+#define BMP280_LOG_STREAM_TEMPERATURE        2
+#define BMP280_LOG_STREAMS                   3
+/* widest zigzag delta */
+#define BMP280_LOG_MAX_WIDTH                 32
+/* largest shift of a stream, deltas are 32 bit */
+#define BMP280_LOG_MAX_SHIFT                 31
+/* block header, all fields little endian */
+#define BMP280_LOG_HEADER_LEN                72
+#define BMP280_LOG_OFFSET_MAGIC              0
+#define BMP280_LOG_OFFSET_PAYLOAD_LEN        4
+#define BMP280_LOG_OFFSET_COUNT              8
+#define BMP280_LOG_OFFSET_VERSION            10
+#define BMP280_LOG_OFFSET_OVERSAMP_P         11
+#define BMP280_LOG_OFFSET_OVERSAMP_T         12
+#define BMP280_LOG_OFFSET_FILTER             13
+#define BMP280_LOG_OFFSET_TIMESTAMP          16
+#define BMP280_LOG_OFFSET_BASE_DELTA         20
+#define BMP280_LOG_OFFSET_SEQ                24
+#define BMP280_LOG_OFFSET_PRESSURE           28
+#define BMP280_LOG_OFFSET_TEMPERATURE        32
+#define BMP280_LOG_OFFSET_WIDTH              36
+#define BMP280_LOG_OFFSET_SHIFT              39
+/* dig_T1 to dig_P9 as in the calibration registers */
+#define BMP280_LOG_OFFSET_CALIB              44
+/* index entry, all fields little endian */
+#define BMP280_LOG_INDEX_LEN                 48
+#define BMP280_LOG_INDEX_OFFSET              0
+#define BMP280_LOG_INDEX_FIRST_TIME          8
+#define BMP280_LOG_INDEX_LAST_TIME           16
+#define BMP280_LOG_INDEX_MIN_PRESSURE        24
+#define BMP280_LOG_INDEX_MAX_PRESSURE        28
+#define BMP280_LOG_INDEX_MIN_TEMPERATURE     32
+#define BMP280_LOG_INDEX_MAX_TEMPERATURE     36
+#define BMP280_LOG_INDEX_COUNT               40
+/* open bounds of a query */
+#define BMP280_LOG_QUERY_MAX_UNCOMP          \
+(BMP280_UNCOMP_CODE_COUNT - BMP280_ONE_U8X)
+#define BMP280_LOG_QUERY_MAX_TEMPERATURE     0x7FFFFFFF
+#define BMP280_LOG_QUERY_MIN_TEMPERATURE     \
+(-BMP280_LOG_QUERY_MAX_TEMPERATURE - BMP280_ONE_U8X)
+/************************************************/
+/**\name	CONVERSION WAIT DEFINITION       */
+/***********************************************/
+/* status polls after a microsecond wait, covers a late conversion */
+#define BMP280_WAIT_POLL_USEC                100
+#define BMP280_WAIT_POLL_MAX                 20
+/************************************************/
+/**\name	EDF SCHEDULER DEFINITION       */
+/***********************************************/
+/* bus utilization is given in parts per million */
+#define BMP280_EDF_FULL_UTILIZATION_PPM      1000000
 /************************************************/
 /**\name	CALIBRATION PARAMETERS DEFINITION       */
 /***********************************************/
@@ -804,6 +1026,20 @@ struct bmp280_calib_param_t {
 
 	s32 t_fine;/**<calibration t_fine data*/
 };
+/*!
+ * @brief This structure holds the compensation result of the last
+ * raw temperature and the pressure coefficients of its t_fine
+ */
+struct bmp280_comp_memo_t {
+	s32 uncomp_temperature;/**< raw temperature of the result*/
+	s32 temperature;/**< temperature in 0.01 DegC*/
+	s32 t_fine;/**< t_fine of the raw temperature*/
+	s32 p_divisor;/**< pressure divisor derived from t_fine*/
+	s32 p_offset;/**< pressure offset derived from t_fine*/
+	u8 valid;/**< the result is usable*/
+	u32 hit_count;/**< samples that reused the result*/
+	u32 miss_count;/**< samples that recomputed it*/
+};
 /*!
  * @brief This structure holds BMP280 initialization parameters
  */
@@ -819,6 +1055,554 @@ struct bmp280_t {
 	BMP280_WR_FUNC_PTR;/**< bus write function pointer*/
 	BMP280_RD_FUNC_PTR;/**< bus read function pointer*/
 	void(*delay_msec)(BMP280_MDELAY_DATA_TYPE);/**< delay function pointer*/
+	void (*delay_usec)(u32);
+	/**< optional microsecond delay, used by forced mode when set;
+	must be BMP280_NULL when unused, e.g. by zeroing the structure*/
+	u8 filter;/**< IIR filter coefficient, cached by the filter APIs*/
+	struct bmp280_comp_memo_t memo;
+	/**< last temperature result, reset with the calibration*/
+};
+/*!
+ * @brief This structure holds one timestamped pressure and
+ * temperature sample
+ */
+struct bmp280_sample_t {
+	s32 uncomp_pressure;/**< uncompensated pressure*/
+	s32 uncomp_temperature;/**< uncompensated temperature*/
+	u32 pressure;/**< compensated pressure in Pa*/
+	s32 temperature;/**< compensated temperature in 0.01 DegC*/
+	u32 timestamp_usec;/**< time of the bus read in us*/
+	u32 seq;/**< sequence number of the sample*/
+	u8 status;/**< status register at the time of the read*/
+};
+/*!
+ * @brief This structure holds a pluggable timer for the
+ * asynchronous operations: schedule has to call fn(arg) once
+ * the time source has reached deadline_usec
+ */
+struct bmp280_timer_t {
+	void (*schedule)(void *, u32, void (*)(void *), void *);
+	/**< arm a one-shot callback: context, deadline_usec, fn, arg*/
+	u32 (*get_time_usec)(void *);/**< monotonic time in us*/
+	void *context;/**< executor or event loop of the timer*/
+};
+/*!
+ * @brief This structure holds one asynchronous measurement
+ */
+struct bmp280_op_t {
+	struct bmp280_t *dev;/**< the sensor*/
+	struct bmp280_stream_t *stream;/**< stream for normal mode*/
+	const struct bmp280_timer_t *timer;/**< timer of the executor*/
+	void (*complete)(struct bmp280_op_t *);/**< completion callback*/
+	void *user_data;/**< e.g. the coroutine to resume*/
+	struct bmp280_sample_t sample;/**< the result*/
+	s8 com_rslt;/**< bus result of the operation*/
+	struct bmp280_op_t *next_free;/**< free list link of the pool*/
+};
+/*!
+ * @brief This structure holds a free list of operations
+ * so that no memory is allocated per measurement
+ */
+struct bmp280_op_pool_t {
+	struct bmp280_op_t *free_list;/**< first free operation*/
+};
+/*!
+ * @brief This structure holds the trigger skew statistics
+ * of synchronized multi-sensor sampling
+ */
+struct bmp280_skew_stat_t {
+	u32 count;/**< number of trigger rounds*/
+	u32 last_skew_usec;/**< skew of the last round*/
+	u32 min_skew_usec;/**< smallest skew seen*/
+	u32 max_skew_usec;/**< largest skew seen*/
+	u32 mean_skew_usec;/**< mean of the skew*/
+	s32 rem_skew_usec;/**< sum of the skews - mean * count*/
+	u32 target_skew_usec;/**< skew bound set by the user*/
+	u32 over_target_count;/**< rounds above the skew bound*/
+};
+/*!
+ * @brief This structure holds the state of the pressure-only
+ * read path that reuses a cached temperature
+ * @note The refresh interval halves when t_fine moved more than
+ * drift_bound since the previous refresh and grows back up to
+ * max_interval while it stays below half the bound.
+ */
+struct bmp280_fast_read_t {
+	u16 max_interval;/**< samples per temperature refresh, at most*/
+	u16 interval;/**< current samples per temperature refresh*/
+	u16 countdown;/**< pressure-only reads left before a refresh*/
+	u8 valid;/**< the cached temperature is usable*/
+	s32 drift_bound;/**< t_fine change that shortens the interval*/
+	s32 t_fine;/**< t_fine of the last temperature refresh*/
+	s32 temperature;/**< temperature of the last refresh*/
+	u32 temperature_read_count;/**< reads with temperature*/
+	u32 pressure_only_count;/**< reads of the pressure bytes only*/
+};
+/*!
+ * @brief This structure holds an event trigger on pressure or
+ * temperature that is evaluated on raw samples
+ * @note The physical bounds are compiled into raw codes for the
+ * current t_fine and compiled again when the raw temperature moved.
+ * A pressure key is the negated raw code, so keys of both channels
+ * grow with the physical value.
+ */
+struct bmp280_trigger_t {
+	u8 type;/**< BMP280_TRIGGER_ABOVE, _BELOW or _RATE*/
+	u8 channel;/**< BMP280_CHANNEL_PRESSURE or _TEMPERATURE*/
+	u8 armed;/**< a level trigger may fire*/
+	u8 fired;/**< set when the last sample fired the trigger*/
+	s32 level;/**< level in Pa or 0.01 DegC*/
+	s32 hysteresis;/**< distance to re-arm a level trigger*/
+	u32 rate;/**< rate in Pa or 0.01 DegC per second*/
+	u8 compiled;/**< the raw bounds are valid*/
+	s32 compiled_uncomp_temperature;/**< raw temperature of the bounds*/
+	s32 key_fire;/**< raw key that fires a level trigger*/
+	s32 key_rearm;/**< raw key that re-arms a level trigger*/
+	u32 raw_rate;/**< rate in raw codes per second*/
+	u8 has_last;/**< last_key and last_usec are valid*/
+	s32 last_key;/**< raw key of the previous sample*/
+	u32 last_usec;/**< timestamp of the previous sample*/
+	u32 fire_count;/**< number of times the trigger fired*/
+	u32 compile_count;/**< number of compilations*/
+};
+/*!
+ * @brief This structure holds a delta-publish stage that
+ * suppresses samples which did not move beyond a deadband
+ * @note The deadbands are converted to raw codes at the current
+ * operating point and converted again when the raw temperature
+ * moved by more than tolerance codes.
+ */
+struct bmp280_publish_t {
+	u32 deadband_pressure;/**< pressure deadband in Pa*/
+	u32 deadband_temperature;/**< temperature deadband in 0.01 DegC*/
+	u32 max_silence_usec;/**< longest time without a sample, 0 off*/
+	u32 heartbeat_usec;/**< longest time without a message, 0 off*/
+	s32 tolerance;/**< raw temperature change that recompiles*/
+	u8 compiled;/**< the raw deadbands are valid*/
+	u8 has_last;/**< a sample has been published*/
+	s32 compiled_uncomp_temperature;/**< raw temperature of the deadbands*/
+	u32 raw_deadband_pressure;/**< pressure deadband in raw codes*/
+	u32 raw_deadband_temperature;/**< temperature deadband in raw codes*/
+	s32 last_uncomp_pressure;/**< raw pressure last published*/
+	s32 last_uncomp_temperature;/**< raw temperature last published*/
+	u32 last_publish_usec;/**< time of the last published sample*/
+	u32 last_message_usec;/**< time of the last sample or heartbeat*/
+	u32 sample_count;/**< evaluated samples*/
+	u32 publish_count;/**< published samples*/
+	u32 heartbeat_count;/**< heartbeats*/
+};
+/*!
+ * @brief This structure holds a software IIR filter stage on
+ * raw pressure and temperature codes
+ * @note The recurrence is the one of the on-chip filter:
+ * x_filt = (x_filt_prev * (c - 1) + x) / c with c = 2^coeff.
+ * The state keeps BMP280_IIR_FRAC_BITS fractional bits and the
+ * outputs are rounded, so a constant input is reached from both
+ * sides. A state truncated to whole codes would stall up to c - 1
+ * codes below a rising input. The chip's internal precision is not
+ * documented, so outputs may differ from the chip's by one code.
+ */
+struct bmp280_iir_t {
+	u8 coeff;/**< BMP280_FILTER_COEFF_OFF to _16*/
+	u8 primed;/**< the state holds a filtered value*/
+	s32 pressure;/**< filtered raw pressure, rounded*/
+	s32 temperature;/**< filtered raw temperature, rounded*/
+	s32 pressure_state;/**< pressure state, fixed point*/
+	s32 temperature_state;/**< temperature state, fixed point*/
+};
+/*!
+ * @brief This structure holds a decimation stage on raw
+ * pressure and temperature codes
+ * @note The stage is a CIC decimator: order integrators run at
+ * the input rate, order combs at the output rate. Order 1 is a
+ * boxcar average over ratio samples. The sums wrap modulo 2^32,
+ * which the combs undo as long as ratio^order stays within
+ * BMP280_DECIM_MAX_GAIN.
+ */
+struct bmp280_decim_t {
+	u16 ratio;/**< input samples per output sample*/
+	u16 phase;/**< input samples since the last output*/
+	u8 order;/**< 1 for boxcar, up to BMP280_DECIM_MAX_ORDER*/
+	u8 settle;/**< outputs to drop while the combs fill*/
+	u8 resolution_pressure;/**< effective pressure resolution in bits*/
+	u8 resolution_temperature;/**< effective temperature resolution*/
+	u32 gain;/**< ratio^order*/
+	u32 integ_pressure[BMP280_DECIM_MAX_ORDER];/**< integrators*/
+	u32 comb_pressure[BMP280_DECIM_MAX_ORDER];/**< comb delays*/
+	u32 integ_temperature[BMP280_DECIM_MAX_ORDER];/**< integrators*/
+	u32 comb_temperature[BMP280_DECIM_MAX_ORDER];/**< comb delays*/
+	struct bmp280_sample_t out;/**< latest decimated sample*/
+};
+/*!
+ * @brief This structure holds the jitter statistics of
+ * samples taken on a fixed time grid
+ */
+struct bmp280_jitter_stat_t {
+	u32 count;/**< number of samples*/
+	s32 last_jitter_usec;/**< actual minus planned time, last sample*/
+	s32 min_jitter_usec;/**< smallest jitter seen*/
+	s32 max_jitter_usec;/**< largest jitter seen*/
+	s32 mean_jitter_usec;/**< mean of the jitter*/
+	s32 rem_jitter_usec;/**< sum of the jitter - mean * count*/
+	u32 skip_count;/**< grid slots skipped, kept by the sampler*/
+};
+/*!
+ * @brief This structure holds a lock-free single producer,
+ * single consumer ring of samples
+ * @note Each index lives on its own cache line together with the
+ * producer's or consumer's cached copy of the other index.
+ */
+struct bmp280_ring_t {
+	volatile u32 head;/**< next slot to write, producer owned*/
+	u32 tail_cache;/**< producer copy of tail*/
+	u32 drop_count;/**< samples dropped because the ring was full*/
+	u8 pad_producer[BMP280_CACHE_LINE_SIZE - 3 * sizeof(u32)];
+	/**< keeps the producer line private*/
+	volatile u32 tail;/**< next slot to read, consumer owned*/
+	u32 head_cache;/**< consumer copy of head*/
+	u8 pad_consumer[BMP280_CACHE_LINE_SIZE - 2 * sizeof(u32)];
+	/**< keeps the consumer line private*/
+	struct bmp280_sample_t *buffer;/**< storage of mask + 1 samples*/
+	u32 mask;/**< capacity - 1, the capacity is a power of two*/
+};
+/*!
+ * @brief This structure holds the latest sample of one sensor
+ * under a sequence lock
+ * @note seq is odd while the single writer updates the slot.
+ * Each slot fills one cache line, so sensors do not share lines.
+ */
+struct bmp280_latest_t {
+	volatile u32 seq;/**< sequence lock, even when stable*/
+	struct bmp280_sample_t sample;/**< the latest sample*/
+	u8 pad[BMP280_CACHE_LINE_SIZE - sizeof(u32)
+	- sizeof(struct bmp280_sample_t)];/**< fills the cache line*/
+};
+/*!
+ * @brief This structure holds a table of latest samples, laid
+ * out to be placed in memory shared between processes
+ */
+struct bmp280_latest_table_t {
+	volatile u32 magic;/**< BMP280_LATEST_MAGIC once initialized*/
+	u32 count;/**< slots in use*/
+	u8 pad[BMP280_CACHE_LINE_SIZE - 2 * sizeof(u32)];
+	/**< keeps the header line apart from the slots*/
+	struct bmp280_latest_t slot[BMP280_LATEST_MAX_SENSORS];/**< slots*/
+};
+/*!
+ * @brief This structure holds the header of a broadcast ring of
+ * samples that is shared between processes
+ * @note The mask + 1 samples follow the header, see
+ * BMP280_SHM_RING_SLOT. The ring holds no pointers, so it can be
+ * mapped at any address; each reader keeps its own cursor.
+ */
+struct bmp280_shm_ring_t {
+	volatile u32 magic;/**< BMP280_SHM_RING_MAGIC once initialized*/
+	u32 mask;/**< capacity - 1, the capacity is a power of two*/
+	u8 pad_header[BMP280_CACHE_LINE_SIZE - 2 * sizeof(u32)];
+	/**< keeps the constant header line apart*/
+	volatile u32 head;/**< samples published, writer owned*/
+	u8 pad_producer[BMP280_CACHE_LINE_SIZE - sizeof(u32)];
+	/**< keeps the producer line private*/
+};
+/* the sample log keeps 64 bit offsets and times */
+#if defined(BMP280_ENABLE_INT64) && defined(BMP280_64BITSUPPORT_PRESENT)
+/*!
+ * @brief This structure holds the decoded header of a sample
+ * log block
+ * @note A block stores the first sample in full and the others
+ * as deltas: delta-of-delta for the timestamps, plain deltas for
+ * the raw codes. Each stream is zigzag coded, stripped of its
+ * common trailing zero bits and bit-packed at a fixed width.
+ */
+struct bmp280_log_block_t {
+	struct bmp280_calib_param_t calib_param;
+	/**< calibration of the logging device*/
+	u32 first_timestamp_usec;/**< timestamp of the first sample*/
+	u32 base_delta_usec;/**< time between the first two samples*/
+	u32 first_seq;/**< sequence number of the first sample*/
+	s32 first_pressure;/**< raw pressure of the first sample*/
+	s32 first_temperature;/**< raw temperature of the first sample*/
+	u32 payload_len;/**< bytes of packed deltas, padded*/
+	const u8 *payload;/**< packed deltas in the caller's buffer*/
+	u16 count;/**< samples in the block*/
+	u8 oversamp_pressure;/**< osrs_p while logging*/
+	u8 oversamp_temperature;/**< osrs_t while logging*/
+	u8 filter;/**< IIR filter coefficient while logging*/
+	u8 width[BMP280_LOG_STREAMS];/**< bits per packed delta*/
+	u8 shift[BMP280_LOG_STREAMS];/**< trailing zero bits removed*/
+};
+/*!
+ * @brief This structure holds the bit reader over the payload
+ * of a log block, with the width, mask and shift of each stream
+ * kept together for the decode loop, and the last decoded sample
+ * so that a block can be decoded in pieces
+ */
+struct bmp280_log_unpack_t {
+	const u8 *in;/**< next payload byte*/
+	u64 acc;/**< bits read but not yet used*/
+	u8 fill;/**< number of bits in acc*/
+	u8 width[BMP280_LOG_STREAMS];/**< bits per packed delta*/
+	u8 shift[BMP280_LOG_STREAMS];/**< trailing zero bits removed*/
+	u64 mask[BMP280_LOG_STREAMS];/**< 2^width - 1*/
+	u32 timestamp_usec;/**< timestamp of the last sample*/
+	u32 delta_usec;/**< sample interval of the last sample*/
+	s32 pressure;/**< raw pressure of the last sample*/
+	s32 temperature;/**< raw temperature of the last sample*/
+	u32 seq;/**< sequence number of the next sample*/
+	u16 index;/**< samples decoded*/
+	u16 count;/**< samples in the block*/
+};
+/*!
+ * @brief This structure holds a cursor over a log held in memory,
+ * e.g. a mapped file
+ * @note Blocks are used in place: block.payload points into the
+ * log and samples are only decoded when asked for.
+ */
+struct bmp280_log_cursor_t {
+	const u8 *data;/**< start of the log*/
+	u64 len;/**< bytes of the log*/
+	u64 offset;/**< position of the next block*/
+	struct bmp280_log_block_t block;/**< current block*/
+	struct bmp280_log_unpack_t unpack;/**< decode state in the block*/
+	u32 block_count;/**< blocks entered*/
+};
+/*!
+ * @brief This structure holds the index entry of a log block:
+ * where it is, the time it covers and the range of its raw codes
+ */
+struct bmp280_log_index_t {
+	u64 offset;/**< position of the block in the log*/
+	u64 first_time_usec;/**< 64 bit time of the first sample*/
+	u64 last_time_usec;/**< 64 bit time of the last sample*/
+	s32 min_pressure;/**< smallest raw pressure*/
+	s32 max_pressure;/**< largest raw pressure*/
+	s32 min_temperature;/**< smallest raw temperature*/
+	s32 max_temperature;/**< largest raw temperature*/
+	u32 count;/**< samples in the block*/
+};
+/*!
+ * @brief This structure holds a range query over a sample log
+ * @note The time and raw ranges are checked against the index,
+ * so they let whole blocks be skipped; samples within them are
+ * compensated and checked against the physical ranges. All
+ * bounds are inclusive.
+ */
+struct bmp280_log_query_t {
+	u64 from_time_usec;/**< start of the time range*/
+	u64 to_time_usec;/**< end of the time range*/
+	s32 min_uncomp_pressure;/**< raw pressure range*/
+	s32 max_uncomp_pressure;/**< raw pressure range*/
+	s32 min_uncomp_temperature;/**< raw temperature range*/
+	s32 max_uncomp_temperature;/**< raw temperature range*/
+	u32 min_pressure;/**< pressure range in Pa*/
+	u32 max_pressure;/**< pressure range in Pa*/
+	s32 min_temperature;/**< temperature range in 0.01 DegC*/
+	s32 max_temperature;/**< temperature range in 0.01 DegC*/
+	u32 block_count;/**< blocks checked against the index*/
+	u32 block_skip_count;/**< blocks skipped by the index*/
+	u32 compensated_count;/**< samples compensated*/
+	u32 match_count;/**< samples matching the query*/
+};
+/*!
+ * @brief This structure holds a sample log writer that collects
+ * samples of one device into blocks
+ * @note time_usec extends the 32 bit timestamps across wraps for
+ * the index; it starts at 0 and may be set after
+ * bmp280_log_writer_init() to the absolute time of the first
+ * sample, e.g. in microseconds since the epoch. offset may be set
+ * likewise when appending to an existing log.
+ */
+struct bmp280_log_writer_t {
+	const struct bmp280_t *dev;/**< device of the samples*/
+	struct bmp280_sample_t *sample;/**< samples of the open block*/
+	u16 count;/**< samples in the open block*/
+	u16 capacity;/**< samples per block*/
+	u32 block_count;/**< blocks written*/
+	u64 offset;/**< position of the next block in the log*/
+	u64 time_usec;/**< 64 bit time of the last sample*/
+	u64 block_time_usec;/**< 64 bit time of the open block*/
+	u32 timestamp_usec;/**< timestamp of the last sample*/
+	struct bmp280_log_index_t index;/**< entry of the last block*/
+};
+#endif
+/*!
+ * @brief This structure holds one subscriber of a fan-out hub
+ * @note The cursor is written by the subscriber only and sits on
+ * its own cache line.
+ */
+struct bmp280_hub_sub_t {
+	u32 period_usec;/**< requested sample period*/
+	u32 stride;/**< hub samples per delivered sample*/
+	volatile u32 cursor;/**< next hub sample to deliver*/
+	u32 lost_count;/**< samples overwritten before delivery*/
+	u8 pad[BMP280_CACHE_LINE_SIZE - 4 * sizeof(u32)];
+	/**< keeps the subscriber line private*/
+};
+/*!
+ * @brief This structure holds a fan-out hub: one producer
+ * publishes every sample of a sensor once into a shared ring,
+ * each subscriber reads its own decimated view of it
+ * @note The producer never waits. A subscriber that falls more
+ * than the ring capacity behind loses the oldest samples.
+ */
+struct bmp280_hub_t {
+	volatile u32 head;/**< samples published, producer owned*/
+	u8 pad_producer[BMP280_CACHE_LINE_SIZE - sizeof(u32)];
+	/**< keeps the producer line private*/
+	struct bmp280_sample_t *buffer;/**< storage of mask + 1 samples*/
+	u32 mask;/**< capacity - 1, the capacity is a power of two*/
+	u32 period_usec;/**< acquisition period, the shortest requested*/
+	struct bmp280_hub_sub_t **sub;/**< the subscribers*/
+	u16 count;/**< number of subscribers*/
+	u16 capacity;/**< size of the subscriber array*/
+};
+/*!
+ * @brief This structure holds one sensor of the EDF scheduler
+ * with its rate target and latency bound
+ */
+struct bmp280_edf_task_t {
+	struct bmp280_t *dev;/**< the device*/
+	u32 period_usec;/**< 1000000 / target ODR in Hz*/
+	u32 latency_usec;/**< bound from release to delivery*/
+	u8 mode;/**< BMP280_FORCED_MODE or BMP280_NORMAL_MODE*/
+	u8 state;/**< BMP280_ASYNC_STATE_IDLE or _CONVERTING*/
+	u32 release_usec;/**< release of the current job*/
+	u32 deadline_usec;/**< absolute deadline of the current job*/
+	u32 ready_usec;/**< end of the running conversion*/
+	u32 trigger_usec;/**< time of the last trigger*/
+	u32 seq;/**< number of delivered samples*/
+	u32 miss_count;/**< late or skipped jobs*/
+	u32 max_response_usec;/**< longest release to delivery time*/
+	u32 density_ppm;/**< bus share taken at admission*/
+	void (*sample_cb)(struct bmp280_edf_task_t *task,
+	const struct bmp280_sample_t *sample, s8 com_rslt);
+	/**< called with each sample, or BMP280_NULL on failure*/
+	void *user_data;/**< user pointer for the callback*/
+};
+/*!
+ * @brief This structure holds the earliest deadline first
+ * scheduler of the sensors sharing one bus
+ */
+struct bmp280_edf_t {
+	struct bmp280_edf_task_t **task;/**< the admitted sensors*/
+	u16 count;/**< number of admitted sensors*/
+	u16 capacity;/**< size of the task array*/
+	u32 xfer_usec;/**< bus model: time of one trigger or read*/
+	u32 utilization_ppm;/**< admitted bus utilization*/
+	u32 job_count;/**< number of delivered samples*/
+	u32 miss_count;/**< late or skipped jobs of all sensors*/
+};
+/*!
+ * @brief This structure holds one step of a bus transaction
+ */
+struct bmp280_xfer_t {
+	u8 type;/**< BMP280_XFER_WRITE, _READ or _WAIT*/
+	u8 reg_addr;/**< register address of a read or write*/
+	u8 len;/**< number of bytes of a read or write*/
+	u8 *data;/**< data of a read or write*/
+	u32 wait_usec;/**< duration of a wait*/
+};
+/*!
+ * @brief This structure holds a sequence of steps for one device
+ * that is executed on a shared bus without interleaving other
+ * transactions of the same device
+ * @note The bus is released during wait steps, so transactions
+ * of other devices run while a device converts.
+ */
+struct bmp280_txn_t {
+	struct bmp280_t *dev;/**< device of the transaction*/
+	struct bmp280_xfer_t step[BMP280_TXN_MAX_STEPS];/**< the steps*/
+	u8 step_count;/**< number of steps*/
+	u8 step_index;/**< next step to execute*/
+	u8 data[BMP280_TXN_DATA_LEN];/**< scratch data for the steps*/
+	u32 submit_usec;/**< time of submission*/
+	u32 ready_usec;/**< end of the current wait*/
+	void (*done)(struct bmp280_txn_t *txn);
+	/**< called when all steps ran or one failed*/
+	void *user_data;/**< user pointer for the callback*/
+	struct bmp280_txn_t *next;/**< next pending transaction*/
+	s8 com_rslt;/**< result of the transaction*/
+};
+/*!
+ * @brief This structure holds a shared I2C bus or SPI
+ * controller and its queue of pending transactions
+ */
+struct bmp280_bus_t {
+	struct bmp280_txn_t *head;/**< oldest pending transaction*/
+	struct bmp280_txn_t *tail;/**< newest pending transaction*/
+	u32 (*get_time_usec)(void);/**< monotonic time in us*/
+	void (*lock)(void *context);/**< optional, guards the queue*/
+	void (*unlock)(void *context);/**< optional, guards the queue*/
+	void *lock_context;/**< argument of lock and unlock*/
+	u16 count;/**< number of pending transactions*/
+	u32 txn_count;/**< number of completed transactions*/
+	u32 max_latency_usec;/**< longest submit to completion time*/
+};
+/*!
+ * @brief This structure holds one sensor scheduled
+ * by the acquisition engine in forced mode
+ */
+struct bmp280_async_t {
+	struct bmp280_t *dev;/**< the sensor*/
+	u32 interval_usec;/**< sampling interval*/
+	u32 deadline_usec;/**< time of the next trigger or read*/
+	u32 slot_usec;/**< planned time of the last trigger*/
+	u32 trigger_usec;/**< actual time of the last trigger*/
+	u32 seq;/**< sequence number of the last sample*/
+	u32 overrun_count;/**< trigger slots skipped because of lateness*/
+	u16 heap_index;/**< position in the engine heap*/
+	u8 state;/**< idle or converting*/
+	void (*sample_cb)(struct bmp280_async_t *,
+	const struct bmp280_sample_t *, s8);/**< sample callback*/
+	void *user_data;/**< user pointer for the callback*/
+	struct bmp280_ring_t *ring;/**< ring filled with every sample*/
+	struct bmp280_hub_t *hub;/**< hub fed with every sample*/
+};
+/*!
+ * @brief This structure holds the deadline heap of
+ * the acquisition engine
+ */
+struct bmp280_engine_t {
+	struct bmp280_async_t **heap;/**< deadline ordered min-heap*/
+	u16 count;/**< sensors in the heap*/
+	u16 capacity;/**< size of the heap storage*/
+	u32 event_count;/**< processed trigger and read events*/
+	u32 max_late_usec;/**< largest lateness of an event*/
+	u32 mean_late_usec;/**< running mean of the event lateness*/
+	s32 late_fixed;/**< running mean in 1/MEAN_WINDOW us*/
+};
+/*!
+ * @brief This structure holds the state of the normal mode
+ * stream reader
+ */
+struct bmp280_stream_t {
+	u8 ctrl_meas;/**< cached ctrl_meas register*/
+	u8 config;/**< cached config register*/
+	u8 started;/**< at least one sample has been read*/
+	u8 bracketed;/**< previous read returned a duplicate*/
+	u8 probing;/**< pending read is an early probe*/
+	u8 probe_count;/**< fresh samples since the last early probe*/
+	u8 anchored;/**< a conversion end has been measured*/
+
+	u32 meas_usec;/**< measurement time of one cycle*/
+	u32 period_usec;/**< estimated normal mode cycle time*/
+	u32 guard_usec;/**< margin kept after the estimated conversion end*/
+	u32 phase_usec;/**< estimated end of the last fresh conversion*/
+	u32 bracket_usec;/**< time of the last duplicate read*/
+	u32 retry_usec;/**< delay before re-reading after a duplicate*/
+	u32 probe_offset_usec;/**< lead of the next early probe*/
+	u32 anchor_usec;/**< last measured conversion end*/
+	u32 anchor_cycles;/**< cycles elapsed since anchor_usec*/
+	u32 next_read_usec;/**< time at which the next read is due*/
+
+	s32 last_uncomp_pressure;/**< raw pressure of the last read*/
+	s32 last_uncomp_temperature;/**< raw temperature of the last read*/
+	u8 last_status;/**< status byte of the last read*/
+
+	u32 seq;/**< sequence number of the last fresh sample*/
+	u32 read_count;/**< number of bus reads*/
+	u32 duplicate_count;/**< reads that returned stale data*/
+	u32 missed_count;/**< conversions that were never read*/
 };
 /**************************************************************/
 /**\name	FUNCTION DECLARATIONS                         */
@@ -831,6 +1615,7 @@ struct bmp280_t {
  *	the bus read and bus write functions
  *  and assign the chip id and I2C address of the BMP280 sensor
  *	chip id is read in the register 0xD0 bit from 0 to 7
+ *	the oversampling and the filter are read back into the cache
  *
  *	@param *bmp280 structure pointer.
  *
@@ -842,6 +1627,10 @@ struct bmp280_t {
  *	affect the reference value of the parameter
  *	(Better case don't change the reference value of the parameter)
  *
+ *	@note delay_usec is optional and is only called when it is not
+ *	BMP280_NULL. Zero the structure before filling it in, so that
+ *	callers which do not set delay_usec fall back to delay_msec.
+ *
  *
  *
  *
@@ -861,6 +1650,8 @@ BMP280_RETURN_FUNCTION_TYPE bmp280_init(struct bmp280_t *bmp280);
  *	@note 0xFA -> MSB -> bit from 0 to 7
  *	@note 0xFB -> LSB -> bit from 0 to 7
  *	@note 0xFC -> LSB -> bit from 4 to 7
+ *	@note 0xFC is not read when the oversampling is x1 and
+ *	the filter is off, its bits are zero then
  *
  *	@param v_uncomp_temperature_s32 : The uncompensated temperature.
  *
@@ -902,6 +1693,8 @@ s32 bmp280_compensate_T_int32(s32 v_uncomp_temperature_s32);
  *	@note 0xF7 -> MSB -> bit from 0 to 7
  *	@note 0xF8 -> LSB -> bit from 0 to 7
  *	@note 0xF9 -> LSB -> bit from 4 to 7
+ *	@note 0xF9 is not read when the oversampling is x1 and
+ *	the filter is off, its bits are zero then
  *
  *
  *
@@ -942,6 +1735,8 @@ u32 bmp280_compensate_P_int32(s32 v_uncomp_pressure_s32);
 /**************************************************************/
 /*!
  * @brief reads uncompensated pressure and temperature
+ * @note The temperature XLSB 0xFC is not read when the temperature
+ * oversampling is x1 and the filter is off, its bits are zero then
  *
  *
  * @param  v_uncomp_pressure_s32: The value of uncompensated pressure.
@@ -959,6 +1754,8 @@ s32 *v_uncomp_pressure_s32, s32 *v_uncomp_temperature_s32);
 /**************************************************************/
 /*!
  * @brief This API reads the true pressure and temperature
+ * @note The temperature, t_fine and pressure coefficients are
+ * reused from the previous call while the raw temperature is unchanged
  *
  *
  *  @param  v_pressure_u32 : The value of compensated pressure.
@@ -1354,6 +2151,8 @@ BMP280_RETURN_FUNCTION_TYPE bmp280_set_work_mode(u8 v_work_mode_u8);
 /*!
  *	@brief This API used to read both
  *	uncompensated pressure and temperature in forced mode
+ *	@note The conversion wait uses delay_usec when it is set,
+ *	else delay_msec rounded up to whole milliseconds.
  *
  *
  *  @param  v_uncomp_pressure_s32: The value of uncompensated pressure.
@@ -1371,6 +2170,166 @@ s32 *v_uncomp_pressure_s32, s32 *v_uncomp_temperature_s32);
 /**************************************************************/
 /**\name	FUNCTION FOR COMMON READ AND WRITE    */
 /**************************************************************/
+/**************************************************************/
+/**\name	FUNCTION FOR FORCED MODE TRIGGER  */
+/**************************************************************/
+/*!
+ *	@brief This API starts one forced mode measurement
+ *	with the cached oversampling settings by writing
+ *	the ctrl_meas register 0xF4
+ *	@note The result is valid after bmp280_compute_wait_time()
+ *
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_trigger_forced_measurement(void);
+/**************************************************************/
+/**\name	FUNCTIONS FOR GROUP FORCED MODE  */
+/**************************************************************/
+/*!
+ *	@brief This API combines the results of several calls, e.g.
+ *	of functions that go over many devices: the first error is
+ *	kept, so errors cannot add up to another code or wrap around
+ *	to SUCCESS
+ *
+ *
+ *
+ *  @param v_rslt_s8 : The result so far
+ *  @param v_next_s8 : The result of the next call
+ *
+ *
+ *  @return the combined result
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_first_error(
+BMP280_RETURN_FUNCTION_TYPE v_rslt_s8, BMP280_RETURN_FUNCTION_TYPE v_next_s8);
+/*!
+ *	@brief This API starts a forced mode measurement on every
+ *	device of a group, back to back without waiting in between
+ *	@note Group functions address the devices directly and leave
+ *	the device selected by bmp280_init() unchanged
+ *
+ *
+ *
+ *  @param a_dev : Array of initialized devices
+ *  @param v_count_u8 : Number of devices in the array
+ *  @param v_wait_usec_u32 : The longest measurement time of the group
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_group_trigger_forced(
+struct bmp280_t *a_dev[], u8 v_count_u8, u32 *v_wait_usec_u32);
+/*!
+ *	@brief This API reads uncompensated pressure and temperature
+ *	from every device of a group, one burst read per device
+ *
+ *
+ *
+ *  @param a_dev : Array of initialized devices
+ *  @param v_count_u8 : Number of devices in the array
+ *  @param a_uncomp_pressure_s32 : Uncompensated pressure per device
+ *  @param a_uncomp_temperature_s32 : Uncompensated temperature per device
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_group_read_uncomp_pressure_temperature(
+struct bmp280_t *a_dev[], u8 v_count_u8,
+s32 a_uncomp_pressure_s32[], s32 a_uncomp_temperature_s32[]);
+/*!
+ *	@brief This API reads uncompensated pressure and temperature
+ *	of a group of devices in forced mode
+ *	@note All devices are triggered first, the group waits once
+ *	for the longest conversion using the delay function of the
+ *	first device, and then every device is read. Devices with a
+ *	delay_usec function are status polled before the read.
+ *	The conversions overlap, so the group period is the longest
+ *	conversion time plus the bus time instead of their sum.
+ *
+ *
+ *
+ *  @param a_dev : Array of initialized devices
+ *  @param v_count_u8 : Number of devices in the array
+ *  @param a_uncomp_pressure_s32 : Uncompensated pressure per device
+ *  @param a_uncomp_temperature_s32 : Uncompensated temperature per device
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE
+bmp280_group_get_forced_uncomp_pressure_temperature(
+struct bmp280_t *a_dev[], u8 v_count_u8,
+s32 a_uncomp_pressure_s32[], s32 a_uncomp_temperature_s32[]);
+/**************************************************************/
+/**\name	FUNCTIONS FOR SYNCHRONIZED MULTI-SENSOR SAMPLING  */
+/**************************************************************/
+/*!
+ *	@brief This API starts a forced mode measurement on every
+ *	device of a group and records when each trigger was issued
+ *	@note The timestamp of a device is taken when its ctrl_meas
+ *	write returns, which is when its conversion starts.
+ *	@note The selected device pointer is not used, so disjoint
+ *	groups, e.g. one per bus, may be triggered from parallel threads.
+ *
+ *
+ *
+ *  @param a_dev : Array of initialized devices
+ *  @param v_count_u8 : Number of devices in the array
+ *  @param get_time_usec : Monotonic time source in us, may be NULL
+ *  @param a_trigger_usec_u32 : Trigger time per device, may be NULL
+ *  @param v_wait_usec_u32 : The longest measurement time of the group
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_group_sync_trigger_forced(
+struct bmp280_t *a_dev[], u8 v_count_u8, u32 (*get_time_usec)(void),
+u32 a_trigger_usec_u32[], u32 *v_wait_usec_u32);
+/*!
+ *	@brief This API adds one synchronized trigger round
+ *	to the skew statistics
+ *	@note The skew of a round is the spread between the earliest
+ *	and the latest trigger timestamp of all devices in the round.
+ *
+ *
+ *
+ *  @param a_trigger_usec_u32 : Trigger time per device
+ *  @param v_count_u8 : Number of devices in the round
+ *  @param skew_stat : The statistics to update
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_sync_update_skew(
+const u32 a_trigger_usec_u32[], u8 v_count_u8,
+struct bmp280_skew_stat_t *skew_stat);
 /*!
  * @brief
  *	This API write the data to
@@ -1381,6 +2340,10 @@ s32 *v_uncomp_pressure_s32, s32 *v_uncomp_temperature_s32);
  *	@param v_data_u8 -> The data from the register
  *	@param v_len_u8 -> no of bytes to read
  *
+ *	@note A write covering the ctrl_meas register 0xF4 reads the
+ *	oversampling back into the cache, one covering the config
+ *	register 0xF5 the filter setting.
+ *
  *
  *	@return results of bus communication function
  *	@retval 0 -> Success
@@ -1488,4 +2451,1951 @@ u32 bmp280_compensate_P_int64(s32 v_uncomp_pressure_s32);
  */
 BMP280_RETURN_FUNCTION_TYPE bmp280_compute_wait_time(u8
 *v_delaytime_u8r);
+/**************************************************************/
+/**\name	FUNCTION FOR MEASUREMENT TIME IN MICROSECONDS  */
+/**************************************************************/
+/*!
+ * @brief Computes the maximum duration of one measurement
+ * for the cached oversampling settings in microseconds
+ *
+ *
+ *
+ *
+ *  @param v_meas_time_u32: The value of measurement time in us
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+ */
+BMP280_RETURN_FUNCTION_TYPE bmp280_compute_meas_time_usec(
+u32 *v_meas_time_u32);
+/**************************************************************/
+/**\name	FUNCTION FOR NORMAL MODE STREAM READER  */
+/**************************************************************/
+/*!
+ *	@brief This API initializes the normal mode stream reader
+ *	from the ctrl_meas (0xF4) and config (0xF5) registers
+ *	@note The cycle time is the measurement time plus t_sb
+ *
+ *
+ *
+ *  @param stream : The stream reader state
+ *
+ *
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_stream_init(
+struct bmp280_stream_t *stream);
+/*!
+ *	@brief This API returns the time until the next stream read is due
+ *
+ *
+ *
+ *  @param stream : The stream reader state
+ *  @param v_now_usec_u32 : The current time in us
+ *  @param v_wait_usec_u32 : The remaining wait time in us, 0 if due
+ *
+ *
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_stream_get_wait_usec(
+struct bmp280_stream_t *stream, u32 v_now_usec_u32,
+u32 *v_wait_usec_u32);
+/*!
+ *	@brief This API reads status and data registers (0xF3 to 0xFC)
+ *	in one burst and reports whether the data is a new conversion
+ *	@note A read is a duplicate when raw pressure, raw temperature and
+ *	status equal the previous read and less than one and a half
+ *	cycles have passed since the estimated end of the last conversion.
+ *	@note Fresh samples are numbered consecutively and compensated,
+ *	duplicates leave the sample untouched.
+ *	@note Reads are scheduled just after the estimated end of each
+ *	conversion; the estimate is corrected whenever a duplicate brackets
+ *	the conversion end, and every BMP280_STREAM_PROBE_INTERVAL samples
+ *	one read is placed early on purpose to track clock drift.
+ *
+ *
+ *
+ *  @param stream : The stream reader state
+ *  @param v_now_usec_u32 : The current time in us
+ *  @param sample : The sample to fill
+ *  @param v_fresh_u8 : 1 for a new conversion, 0 for a duplicate
+ *
+ *
+ *
+ *	@return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_stream_read(
+struct bmp280_stream_t *stream, u32 v_now_usec_u32,
+struct bmp280_sample_t *sample, u8 *v_fresh_u8);
+/**************************************************************/
+/**\name	FUNCTIONS FOR THE ACQUISITION ENGINE  */
+/**************************************************************/
+/*!
+ *	@brief This API initializes an acquisition engine
+ *	on caller provided heap storage
+ *
+ *
+ *
+ *  @param engine : The engine
+ *  @param a_heap : Storage for v_capacity_u16 sensor pointers
+ *  @param v_capacity_u16 : Maximum number of sensors
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_engine_init(
+struct bmp280_engine_t *engine, struct bmp280_async_t **a_heap,
+u16 v_capacity_u16);
+/*!
+ *	@brief This API adds a sensor to the engine; its first
+ *	forced measurement is triggered at v_start_usec_u32
+ *	@note dev, interval_usec, sample_cb, ring and hub (or
+ *	BMP280_NULL) have to be set before
+ *
+ *
+ *
+ *  @param engine : The engine
+ *  @param async : The sensor
+ *  @param v_start_usec_u32 : Time of the first trigger in us
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Engine full
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_engine_add(
+struct bmp280_engine_t *engine, struct bmp280_async_t *async,
+u32 v_start_usec_u32);
+/*!
+ *	@brief This API removes a sensor from the engine
+ *
+ *
+ *
+ *  @param engine : The engine
+ *  @param async : The sensor
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Sensor not in the engine
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_engine_remove(
+struct bmp280_engine_t *engine, struct bmp280_async_t *async);
+/*!
+ *	@brief This API returns the earliest deadline of all sensors
+ *
+ *
+ *
+ *  @param engine : The engine
+ *  @param v_deadline_usec_u32 : The earliest deadline in us
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> No sensor in the engine
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_engine_next_deadline(
+struct bmp280_engine_t *engine, u32 *v_deadline_usec_u32);
+/*!
+ *	@brief This API processes every trigger and read
+ *	that is due at v_now_usec_u32 and never blocks
+ *	@note An idle sensor is triggered in forced mode and its read
+ *	is scheduled after the measurement time; a converting sensor is
+ *	read, compensated, pushed to its ring if one is attached and
+ *	handed to its callback, and its next
+ *	trigger is scheduled on the interval grid. A failed trigger or
+ *	read only reaches the callback, with a NULL sample. Slots that
+ *	are already in the past are skipped and counted as overruns.
+ *	@note Each event costs O(log n), so one thread can serve
+ *	thousands of sensors when it sleeps until the next deadline,
+ *	e.g. on a timerfd armed with bmp280_engine_next_deadline().
+ *
+ *
+ *
+ *  @param engine : The engine
+ *  @param v_now_usec_u32 : The current time in us
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_engine_run(
+struct bmp280_engine_t *engine, u32 v_now_usec_u32);
+/**************************************************************/
+/**\name	FUNCTIONS FOR ASYNCHRONOUS OPERATIONS  */
+/**************************************************************/
+/*!
+ *	@brief This API starts a forced mode measurement as an
+ *	asynchronous operation; instead of calling delay_msec the
+ *	operation arms the timer for the end of the conversion and
+ *	calls op->complete with the compensated sample in op->sample
+ *	@note The operation is owned by the caller and nothing is
+ *	allocated, so it can be embedded in a coroutine frame or taken
+ *	from a struct bmp280_op_pool_t. A C++20 awaitable only has to
+ *	store the coroutine handle in op->user_data and resume it from
+ *	op->complete. When the read fails op->com_rslt holds the error
+ *	and the compensated values and seq of op->sample are kept.
+ *
+ *
+ *
+ *  @param op : The operation, with dev, timer and complete set
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error, op->complete is not called
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_op_forced_measure(struct bmp280_op_t *op);
+/*!
+ *	@brief This API waits asynchronously for the next fresh
+ *	normal mode sample of op->stream; the timer is armed for the
+ *	next scheduled stream read and op->complete is called once a
+ *	new conversion has been read, see bmp280_stream_read()
+ *
+ *
+ *
+ *  @param op : The operation, with dev, stream, timer and complete set
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_op_next_sample(struct bmp280_op_t *op);
+/*!
+ *	@brief This API initializes a free list of operations
+ *
+ *
+ *
+ *  @param pool : The pool
+ *  @param a_op : Storage for the operations
+ *  @param v_count_u16 : Number of operations in the storage
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_op_pool_init(
+struct bmp280_op_pool_t *pool, struct bmp280_op_t *a_op,
+u16 v_count_u16);
+/*!
+ *	@brief This API takes an operation from the pool
+ *
+ *
+ *
+ *  @param pool : The pool
+ *
+ *
+ *  @return the operation, or NULL when the pool is empty
+ *
+ *
+*/
+struct bmp280_op_t *bmp280_op_pool_get(struct bmp280_op_pool_t *pool);
+/*!
+ *	@brief This API returns an operation to the pool
+ *
+ *
+ *
+ *  @param pool : The pool
+ *  @param op : The operation, must not be pending
+ *
+ *
+ *  @return nothing
+ *
+ *
+*/
+void bmp280_op_pool_put(struct bmp280_op_pool_t *pool,
+struct bmp280_op_t *op);
+/**************************************************************/
+/**\name	FUNCTIONS FOR THE SAMPLE RING  */
+/**************************************************************/
+/*!
+ *	@brief This API initializes a single producer,
+ *	single consumer sample ring on caller provided storage
+ *
+ *
+ *
+ *  @param ring : The ring
+ *  @param a_buffer : Storage for v_capacity_u32 samples
+ *  @param v_capacity_u32 : Number of samples, a power of two
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Capacity is not a power of two
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_ring_init(struct bmp280_ring_t *ring,
+struct bmp280_sample_t *a_buffer, u32 v_capacity_u32);
+/*!
+ *	@brief This API appends one sample to the ring;
+ *	called by the producer only
+ *	@note The producer never waits: a full ring drops the
+ *	new sample and counts it in drop_count.
+ *
+ *
+ *
+ *  @param ring : The ring
+ *  @param sample : The sample to copy into the ring
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Ring full, sample dropped
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_ring_push(struct bmp280_ring_t *ring,
+const struct bmp280_sample_t *sample);
+/*!
+ *	@brief This API removes up to v_max_u32 samples from the ring
+ *	in one batch; called by the consumer only
+ *
+ *
+ *
+ *  @param ring : The ring
+ *  @param a_sample : Destination for the samples
+ *  @param v_max_u32 : Size of the destination
+ *  @param v_count_u32 : Number of samples copied
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_ring_pop_batch(
+struct bmp280_ring_t *ring, struct bmp280_sample_t *a_sample,
+u32 v_max_u32, u32 *v_count_u32);
+/**************************************************************/
+/**\name	FUNCTION FOR BATCH COMPENSATION  */
+/**************************************************************/
+/*!
+ *	@brief This API compensates a batch of samples of one device
+ *	from their uncomp_pressure and uncomp_temperature fields
+ *	@note The global device is not used and the calibration is
+ *	not modified, so several threads may compensate samples of
+ *	the same or different devices at the same time.
+ *
+ *
+ *
+ *  @param calib : Calibration data of the device
+ *  @param a_sample : The samples, temperature and pressure are written
+ *  @param v_count_u32 : Number of samples
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_compensate_samples(
+const struct bmp280_calib_param_t *calib,
+struct bmp280_sample_t *a_sample, u32 v_count_u32);
+/**************************************************************/
+/**\name	FUNCTIONS FOR BUS ARBITRATION  */
+/**************************************************************/
+/*!
+ *	@brief This API initializes a shared bus
+ *
+ *
+ *
+ *  @param bus : The bus
+ *  @param get_time_usec : Monotonic time in us, used to time waits
+ *  @param lock : Optional queue lock, BMP280_NULL when a single
+ *	thread submits and services
+ *  @param unlock : Optional queue unlock
+ *  @param lock_context : Argument of lock and unlock
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_bus_init(struct bmp280_bus_t *bus,
+u32 (*get_time_usec)(void), void (*lock)(void *context),
+void (*unlock)(void *context), void *lock_context);
+/*!
+ *	@brief This API starts an empty transaction for a device
+ *
+ *
+ *
+ *  @param txn : The transaction
+ *  @param p_dev : The device
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_txn_init(struct bmp280_txn_t *txn,
+struct bmp280_t *p_dev);
+/*!
+ *	@brief This API appends a step to a transaction
+ *
+ *
+ *
+ *  @param txn : The transaction
+ *  @param v_type_u8 : BMP280_XFER_WRITE, BMP280_XFER_READ
+ *	or BMP280_XFER_WAIT
+ *  @param v_reg_addr_u8 : Register address of a read or write
+ *  @param a_data_u8 : Data of a read or write, it has to stay
+ *	valid until the transaction is done
+ *  @param v_len_u8 : Number of bytes of a read or write
+ *  @param v_wait_usec_u32 : Duration of a wait
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Too many steps
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_txn_add_step(struct bmp280_txn_t *txn,
+u8 v_type_u8, u8 v_reg_addr_u8, u8 *a_data_u8, u8 v_len_u8,
+u32 v_wait_usec_u32);
+/*!
+ *	@brief This API builds a complete forced measurement:
+ *	trigger, wait for the conversion and read the data
+ *	@note Read the result with bmp280_txn_get_uncomp_pressure_temperature
+ *	once the transaction is done.
+ *
+ *
+ *
+ *  @param txn : The transaction
+ *  @param p_dev : The device
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_txn_forced(struct bmp280_txn_t *txn,
+struct bmp280_t *p_dev);
+/*!
+ *	@brief This API decodes the result of a transaction
+ *	built by bmp280_txn_forced
+ *
+ *
+ *
+ *  @param txn : The completed transaction
+ *  @param v_uncomp_pressure_s32 : The uncompensated pressure
+ *  @param v_uncomp_temperature_s32 : The uncompensated temperature
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_txn_get_uncomp_pressure_temperature(
+const struct bmp280_txn_t *txn, s32 *v_uncomp_pressure_s32,
+s32 *v_uncomp_temperature_s32);
+/*!
+ *	@brief This API queues a transaction on a bus
+ *	@note It may be called from any thread when the bus has a lock.
+ *
+ *
+ *
+ *  @param bus : The bus
+ *  @param txn : The transaction, it must not be touched until
+ *	its done callback has been called
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_bus_submit(struct bmp280_bus_t *bus,
+struct bmp280_txn_t *txn);
+/*!
+ *	@brief This API serves every transaction of the bus that is
+ *	ready, in submission order, and never blocks
+ *	@note Each ready transaction runs its steps up to its next wait,
+ *	then the bus moves on, so one pass is bounded by one burst per
+ *	queued transaction. Transactions of the same device run strictly
+ *	one after the other; one that ends with a wait completes once
+ *	the wait has passed. Only one thread may service a bus, and the
+ *	lock, if any, is never held during bus transfers or waits.
+ *
+ *
+ *
+ *  @param bus : The bus
+ *  @param v_next_usec_u32 : Time of the next ready transaction,
+ *	valid when bus->count is not zero
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_bus_service(struct bmp280_bus_t *bus,
+u32 *v_next_usec_u32);
+/**************************************************************/
+/**\name	FUNCTIONS FOR THE EDF SCHEDULER  */
+/**************************************************************/
+/*!
+ *	@brief This API initializes an EDF scheduler for one bus
+ *
+ *
+ *
+ *  @param edf : The scheduler
+ *  @param a_task : Storage for v_capacity_u16 task pointers
+ *  @param v_capacity_u16 : Maximum number of sensors
+ *  @param v_xfer_usec_u32 : Bus model, time of one trigger
+ *	or data read transaction on this bus
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_edf_init(struct bmp280_edf_t *edf,
+struct bmp280_edf_task_t **a_task, u16 v_capacity_u16,
+u32 v_xfer_usec_u32);
+/*!
+ *	@brief This API admits a sensor when the bus model can
+ *	sustain it together with the sensors already admitted
+ *	@note dev, period_usec, latency_usec, mode and sample_cb
+ *	have to be set before. A device in normal mode has to be
+ *	configured with a matching standby time by the caller.
+ *	@note A sensor is refused when its latency bound cannot hold
+ *	its conversion time plus its transfers, or when the summed
+ *	bus density of all sensors would exceed 100 %.
+ *
+ *
+ *
+ *  @param edf : The scheduler
+ *  @param task : The sensor
+ *  @param v_start_usec_u32 : Release of the first job
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Not schedulable or no free slot
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_edf_admit(struct bmp280_edf_t *edf,
+struct bmp280_edf_task_t *task, u32 v_start_usec_u32);
+/*!
+ *	@brief This API removes a sensor and returns its bus share
+ *
+ *
+ *
+ *  @param edf : The scheduler
+ *  @param task : The sensor
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Sensor not admitted
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_edf_remove(struct bmp280_edf_t *edf,
+struct bmp280_edf_task_t *task);
+/*!
+ *	@brief This API runs every bus action that is due at
+ *	v_now_usec_u32 in earliest deadline first order and never blocks
+ *	@note A released job first triggers its forced conversion and
+ *	is read once the conversion time has passed; a job in normal
+ *	mode is read directly. When several actions are due, the one
+ *	whose job has the earliest deadline gets the bus first.
+ *	Deliveries after the deadline and jobs skipped because a whole
+ *	period was lost are counted as misses.
+ *
+ *
+ *
+ *  @param edf : The scheduler
+ *  @param v_now_usec_u32 : The current time in us
+ *  @param v_next_usec_u32 : Time of the next due action,
+ *	valid when edf->count is not zero
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_edf_run(struct bmp280_edf_t *edf,
+u32 v_now_usec_u32, u32 *v_next_usec_u32);
+/**************************************************************/
+/**\name	FUNCTION FOR JITTER STATISTICS  */
+/**************************************************************/
+/*!
+ *	@brief This API adds one sample taken on a fixed time grid
+ *	to the jitter statistics
+ *
+ *
+ *
+ *  @param jitter_stat : The statistics
+ *  @param v_planned_usec_u32 : Grid time of the sample
+ *  @param v_actual_usec_u32 : Time the sample was actually triggered
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_jitter_update(
+struct bmp280_jitter_stat_t *jitter_stat, u32 v_planned_usec_u32,
+u32 v_actual_usec_u32);
+/**************************************************************/
+/**\name	FUNCTIONS FOR THE PRESSURE-ONLY READ PATH  */
+/**************************************************************/
+/*!
+ *	@brief This API initializes the pressure-only read path
+ *
+ *
+ *
+ *  @param fast : The read path state
+ *  @param v_max_interval_u16 : Samples per temperature refresh
+ *	at most, 1 reads the temperature every time
+ *  @param v_drift_bound_s32 : t_fine change between two refreshes
+ *	that shortens the interval (5120 t_fine is about 1 DegC)
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Interval is zero
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_fast_read_init(
+struct bmp280_fast_read_t *fast, u16 v_max_interval_u16,
+s32 v_drift_bound_s32);
+/*!
+ *	@brief This API reads the true pressure and temperature, but
+ *	reads only the three pressure bytes 0xF7 to 0xF9 on most calls
+ *	and compensates them with the cached t_fine
+ *	@note Temperature and t_fine are refreshed with a full six byte
+ *	read every interval samples; the returned temperature is the
+ *	one of the last refresh.
+ *	A failed refresh keeps temperature, t_fine and the interval
+ *	and is retried on the next call.
+ *
+ *
+ *
+ *  @param fast : The read path state
+ *  @param v_pressure_u32 : The value of compensated pressure
+ *  @param v_temperature_s32 : The value of compensated temperature
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Error
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_fast_read_pressure_temperature(
+struct bmp280_fast_read_t *fast, u32 *v_pressure_u32,
+s32 *v_temperature_s32);
+/**************************************************************/
+/**\name	FUNCTIONS FOR INVERSE COMPENSATION  */
+/**************************************************************/
+/*!
+ *	@brief This API maps a pressure back to the raw ADC code
+ *	for a given t_fine, so that pressure thresholds can be
+ *	checked on raw samples without compensating them
+ *	@note The result is the largest raw code whose pressure is at
+ *	least v_pressure_u32. As the compensated pressure falls with the
+ *	raw code, a raw sample above the result is below the pressure
+ *	and any other raw sample is at or above it. The result is -1
+ *	when no code reaches the pressure.
+ *
+ *
+ *
+ *  @param calib : Calibration data of the device
+ *  @param v_t_fine_s32 : The fine temperature the bound is valid for
+ *  @param v_pressure_u32 : The pressure in Pa
+ *  @param v_uncomp_pressure_s32 : The raw pressure code
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_invert_pressure(
+const struct bmp280_calib_param_t *calib, s32 v_t_fine_s32,
+u32 v_pressure_u32, s32 *v_uncomp_pressure_s32);
+/*!
+ *	@brief This API maps a temperature back to the raw ADC code
+ *	@note The result is the smallest raw code whose temperature is
+ *	at least v_temperature_s32. As the compensated temperature rises
+ *	with the raw code, a raw sample at or above the result is at or
+ *	above the temperature. The result is BMP280_UNCOMP_CODE_COUNT
+ *	when no code reaches the temperature.
+ *
+ *
+ *
+ *  @param calib : Calibration data of the device
+ *  @param v_temperature_s32 : The temperature in 0.01 DegC
+ *  @param v_uncomp_temperature_s32 : The raw temperature code
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_invert_temperature(
+const struct bmp280_calib_param_t *calib, s32 v_temperature_s32,
+s32 *v_uncomp_temperature_s32);
+/**************************************************************/
+/**\name	FUNCTIONS FOR RAW DOMAIN TRIGGERS  */
+/**************************************************************/
+/*!
+ *	@brief This API sets up a raw domain trigger
+ *	@note A level trigger starts armed, so it fires on the first
+ *	sample that is already beyond its level.
+ *
+ *
+ *
+ *  @param trigger : The trigger
+ *  @param v_type_u8 : BMP280_TRIGGER_ABOVE, _BELOW or _RATE
+ *  @param v_channel_u8 : BMP280_CHANNEL_PRESSURE or _TEMPERATURE
+ *  @param v_level_s32 : Level in Pa or 0.01 DegC
+ *  @param v_hysteresis_s32 : Distance from the level that re-arms
+ *	a level trigger
+ *  @param v_rate_u32 : Rate in Pa or 0.01 DegC per second
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Unknown type or channel
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_trigger_init(
+struct bmp280_trigger_t *trigger, u8 v_type_u8, u8 v_channel_u8,
+s32 v_level_s32, s32 v_hysteresis_s32, u32 v_rate_u32);
+/*!
+ *	@brief This API evaluates triggers on one raw sample with
+ *	integer compares only
+ *	@note A trigger is compiled again when the raw temperature
+ *	moved by more than v_tolerance_s32 codes since its last
+ *	compilation. Only samples that fire need to be compensated.
+ *
+ *
+ *
+ *  @param calib : Calibration data of the device
+ *  @param a_trigger : The triggers
+ *  @param v_count_u16 : Number of triggers
+ *  @param v_tolerance_s32 : Raw temperature change that
+ *	recompiles a trigger
+ *  @param sample : The sample, only its raw fields and its
+ *	timestamp are used
+ *  @param v_fired_u16 : Number of triggers that fired, each of
+ *	them has its fired flag set
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_trigger_eval(
+const struct bmp280_calib_param_t *calib,
+struct bmp280_trigger_t *a_trigger, u16 v_count_u16,
+s32 v_tolerance_s32, const struct bmp280_sample_t *sample,
+u16 *v_fired_u16);
+/**************************************************************/
+/**\name	FUNCTIONS FOR DELTA PUBLISH  */
+/**************************************************************/
+/*!
+ *	@brief This API sets up a delta-publish stage
+ *
+ *
+ *
+ *  @param publish : The publish stage
+ *  @param v_deadband_pressure_u32 : Pressure change in Pa that is
+ *	published, 0 publishes every change
+ *  @param v_deadband_temperature_u32 : Temperature change in
+ *	0.01 DegC that is published, 0 publishes every change
+ *  @param v_max_silence_usec_u32 : Longest time without a published
+ *	sample, 0 for no limit
+ *  @param v_heartbeat_usec_u32 : Longest time without any message,
+ *	0 for no heartbeat
+ *  @param v_tolerance_s32 : Raw temperature change that
+ *	recompiles the deadbands
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_publish_init(
+struct bmp280_publish_t *publish, u32 v_deadband_pressure_u32,
+u32 v_deadband_temperature_u32, u32 v_max_silence_usec_u32,
+u32 v_heartbeat_usec_u32, s32 v_tolerance_s32);
+/*!
+ *	@brief This API decides from the raw fields of a sample
+ *	whether it has to be published
+ *	@note A sample is published when pressure or temperature moved
+ *	beyond its deadband since the last published sample, or when
+ *	max_silence_usec passed without one. Otherwise a heartbeat is
+ *	due when heartbeat_usec passed without any message. Only
+ *	published samples need to be compensated.
+ *
+ *
+ *
+ *  @param calib : Calibration data of the device
+ *  @param publish : The publish stage
+ *  @param sample : The sample, only its raw fields and its
+ *	timestamp are used
+ *  @param v_action_u8 : BMP280_PUBLISH_NONE, BMP280_PUBLISH_SAMPLE
+ *	or BMP280_PUBLISH_HEARTBEAT
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_publish_eval(
+const struct bmp280_calib_param_t *calib,
+struct bmp280_publish_t *publish, const struct bmp280_sample_t *sample,
+u8 *v_action_u8);
+/**************************************************************/
+/**\name	FUNCTIONS FOR THE SOFTWARE IIR FILTER  */
+/**************************************************************/
+/*!
+ *	@brief This API sets up a software IIR filter stage with the
+ *	coefficients of the on-chip filter
+ *	@note The first sample primes the filter and passes unchanged.
+ *
+ *
+ *
+ *  @param iir : The filter stage
+ *  @param v_coeff_u8 : The filter coefficient
+ *  value             |  coefficient
+ * -------------------|------------------------
+ *	0x00        | BMP280_FILTER_COEFF_OFF
+ *	0x01        | BMP280_FILTER_COEFF_2
+ *	0x02        | BMP280_FILTER_COEFF_4
+ *	0x03        | BMP280_FILTER_COEFF_8
+ *	0x04        | BMP280_FILTER_COEFF_16
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Unknown coefficient
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_iir_init(struct bmp280_iir_t *iir,
+u8 v_coeff_u8);
+/*!
+ *	@brief This API filters the raw fields of one sample in place
+ *
+ *
+ *
+ *  @param iir : The filter stage
+ *  @param sample : The sample, uncomp_pressure and
+ *	uncomp_temperature are replaced by their filtered values
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_iir_apply(struct bmp280_iir_t *iir,
+struct bmp280_sample_t *sample);
+/*!
+ *	@brief This API filters arrays of raw codes in place, e.g.
+ *	to replay a log with a different smoothing
+ *	@note Each channel runs over its own contiguous array with the
+ *	state held in a local, so the loop carries no memory dependency
+ *	besides the recurrence itself. Either array may be BMP280_NULL.
+ *
+ *
+ *
+ *  @param iir : The filter stage
+ *  @param a_uncomp_pressure_s32 : Raw pressure codes
+ *  @param a_uncomp_temperature_s32 : Raw temperature codes
+ *  @param v_count_u32 : Number of codes per array
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_iir_batch(struct bmp280_iir_t *iir,
+s32 *a_uncomp_pressure_s32, s32 *a_uncomp_temperature_s32,
+u32 v_count_u32);
+/**************************************************************/
+/**\name	FUNCTIONS FOR DECIMATION  */
+/**************************************************************/
+/*!
+ *	@brief This API sets up a decimation stage that averages
+ *	(order 1) or CIC-decimates (order 2 and 3) raw codes taken at
+ *	a low oversampling and a high output data rate
+ *	@note Several stages with different ratios can be fed from one
+ *	stream, see bmp280_decim_push_all().
+ *	@note The effective resolution is reported in
+ *	resolution_pressure and resolution_temperature, following the
+ *	datasheet rule of one bit per doubling of the conversions.
+ *
+ *
+ *
+ *  @param decim : The decimation stage
+ *  @param v_ratio_u16 : Input samples per output sample
+ *  @param v_order_u8 : 1 for boxcar, up to BMP280_DECIM_MAX_ORDER
+ *  @param v_oversamp_pressure_u8 : osrs_p of the input stream
+ *  @param v_oversamp_temperature_u8 : osrs_t of the input stream
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> ratio^order above BMP280_DECIM_MAX_GAIN
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_decim_init(struct bmp280_decim_t *decim,
+u16 v_ratio_u16, u8 v_order_u8, u8 v_oversamp_pressure_u8,
+u8 v_oversamp_temperature_u8);
+/*!
+ *	@brief This API feeds one raw sample into a decimation stage
+ *	@note On output, decim->out holds the decimated raw codes, the
+ *	timestamp and status of the last input sample and an output
+ *	sequence number. The compensated fields are left to the caller,
+ *	e.g. bmp280_compensate_samples(), so that only emitted samples
+ *	are compensated.
+ *	@note With order 2 and 3 the first order - 1 outputs are dropped
+ *	while the combs fill.
+ *
+ *
+ *
+ *  @param decim : The decimation stage
+ *  @param sample : The input sample, only the raw fields are used
+ *  @param v_ready_u8 : 1 if decim->out holds a new sample
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_decim_push(struct bmp280_decim_t *decim,
+const struct bmp280_sample_t *sample, u8 *v_ready_u8);
+/*!
+ *	@brief This API feeds one raw sample into several decimation
+ *	stages, e.g. one per output rate served from a single stream
+ *
+ *
+ *
+ *  @param a_decim : The decimation stages
+ *  @param v_count_u8 : Number of stages, at most 32
+ *  @param sample : The input sample
+ *  @param v_ready_u32 : Bit n is set if a_decim[n].out holds a
+ *	new sample
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> More than 32 stages
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_decim_push_all(
+struct bmp280_decim_t *a_decim, u8 v_count_u8,
+const struct bmp280_sample_t *sample, u32 *v_ready_u32);
+/**************************************************************/
+/**\name	FUNCTIONS FOR THE FAN-OUT HUB  */
+/**************************************************************/
+/*!
+ *	@brief This API initializes a fan-out hub on caller provided
+ *	sample and subscriber storage
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param a_buffer : Storage for v_capacity_u32 samples
+ *  @param v_capacity_u32 : Number of samples, a power of two
+ *  @param a_sub : Storage for v_sub_capacity_u16 subscriber pointers
+ *  @param v_sub_capacity_u16 : Maximum number of subscribers
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Capacity is not a power of two
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_init(struct bmp280_hub_t *hub,
+struct bmp280_sample_t *a_buffer, u32 v_capacity_u32,
+struct bmp280_hub_sub_t **a_sub, u16 v_sub_capacity_u16);
+/*!
+ *	@brief This API adds a subscriber with its own sample period
+ *	@note The hub period_usec becomes the shortest period of all
+ *	subscribers; the acquisition engine has to sample the sensor
+ *	at that interval. Each subscriber receives every stride-th
+ *	sample, with stride = its period / the hub period.
+ *	@note Subscribers with the same stride see the same samples.
+ *	Adding or removing subscribers changes the strides, so it has
+ *	to be serialized with the subscribers reading the hub.
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param sub : The subscriber
+ *  @param v_period_usec_u32 : Requested sample period in us
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Hub full or zero period
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_subscribe(struct bmp280_hub_t *hub,
+struct bmp280_hub_sub_t *sub, u32 v_period_usec_u32);
+/*!
+ *	@brief This API removes a subscriber from the hub
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param sub : The subscriber
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Not subscribed
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_unsubscribe(struct bmp280_hub_t *hub,
+struct bmp280_hub_sub_t *sub);
+/*!
+ *	@brief This API publishes one sample to all subscribers;
+ *	called by the producer only
+ *	@note The producer never waits: the sample overwrites the
+ *	oldest slot whether or not every subscriber has read it.
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param sample : The sample to copy into the hub
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_publish(struct bmp280_hub_t *hub,
+const struct bmp280_sample_t *sample);
+/*!
+ *	@brief This API returns the next sample of a subscriber in
+ *	place, without copying it
+ *	@note The slot may be overwritten while it is being used.
+ *	bmp280_hub_release() tells whether it was, in which case
+ *	anything derived from it has to be discarded.
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param sub : The subscriber
+ *  @param sample : The sample in the hub storage, BMP280_NULL if
+ *	no new sample is available
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_peek(struct bmp280_hub_t *hub,
+struct bmp280_hub_sub_t *sub, const struct bmp280_sample_t **sample);
+/*!
+ *	@brief This API moves a subscriber past the sample returned
+ *	by bmp280_hub_peek()
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param sub : The subscriber
+ *  @param v_valid_u8 : 1 if the sample was intact until the
+ *	release, 0 if the producer overwrote it
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_release(struct bmp280_hub_t *hub,
+struct bmp280_hub_sub_t *sub, u8 *v_valid_u8);
+/*!
+ *	@brief This API copies up to v_max_u32 samples of a
+ *	subscriber's view in one batch
+ *	@note Samples overwritten during the copy are left out and
+ *	counted in lost_count.
+ *
+ *
+ *
+ *  @param hub : The hub
+ *  @param sub : The subscriber
+ *  @param a_sample : Destination for the samples
+ *  @param v_max_u32 : Size of the destination
+ *  @param v_count_u32 : Number of samples copied
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_hub_pop_batch(struct bmp280_hub_t *hub,
+struct bmp280_hub_sub_t *sub, struct bmp280_sample_t *a_sample,
+u32 v_max_u32, u32 *v_count_u32);
+/**************************************************************/
+/**\name	FUNCTIONS FOR THE LATEST SAMPLE TABLE  */
+/**************************************************************/
+/*!
+ *	@brief This API initializes a table of latest samples, e.g.
+ *	in a shared memory segment, and marks it valid last
+ *
+ *
+ *
+ *  @param table : The table
+ *  @param v_count_u8 : Number of slots in use
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> More than BMP280_LATEST_MAX_SENSORS slots
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_latest_table_init(
+struct bmp280_latest_table_t *table, u8 v_count_u8);
+/*!
+ *	@brief This API stores the latest sample of a sensor;
+ *	called by the single writer of the slot only
+ *	@note The writer never waits for readers.
+ *
+ *
+ *
+ *  @param slot : The slot of the sensor
+ *  @param sample : The sample to publish
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_latest_write(struct bmp280_latest_t *slot,
+const struct bmp280_sample_t *sample);
+/*!
+ *	@brief This API copies the latest sample of a sensor
+ *	@note Readers never block the writer nor each other. A copy
+ *	that overlaps a write is retried, at most
+ *	BMP280_LATEST_READ_RETRY times, so the read is bounded.
+ *	@note sample->seq tells whether the sample is new to the
+ *	caller; a slot never written reads as all zero.
+ *
+ *
+ *
+ *  @param slot : The slot of the sensor
+ *  @param sample : The copied sample
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> The writer kept the slot busy
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_latest_read(
+const struct bmp280_latest_t *slot, struct bmp280_sample_t *sample);
+/**************************************************************/
+/**\name	FUNCTIONS FOR THE SHARED MEMORY RING  */
+/**************************************************************/
+/*!
+ *	@brief This API returns the size in bytes of a shared memory
+ *	ring, header included
+ *
+ *
+ *
+ *  @param v_capacity_u32 : Number of samples, a power of two
+ *  @param v_size_u32 : The size to map
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Capacity is not a power of two
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_shm_ring_size(u32 v_capacity_u32,
+u32 *v_size_u32);
+/*!
+ *	@brief This API initializes a shared memory ring in a mapping
+ *	of bmp280_shm_ring_size() bytes and marks it valid last
+ *
+ *
+ *
+ *  @param ring : The ring at the start of the mapping
+ *  @param v_capacity_u32 : Number of samples, a power of two
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Capacity is not a power of two
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_shm_ring_init(
+struct bmp280_shm_ring_t *ring, u32 v_capacity_u32);
+/*!
+ *	@brief This API publishes one sample to a shared memory ring;
+ *	called by the single writer only
+ *	@note The writer never waits: the sample overwrites the
+ *	oldest slot whether or not every reader has read it.
+ *
+ *
+ *
+ *  @param ring : The ring
+ *  @param sample : The sample to copy into the ring
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_shm_ring_publish(
+struct bmp280_shm_ring_t *ring, const struct bmp280_sample_t *sample);
+/*!
+ *	@brief This API copies up to v_max_u32 samples from a shared
+ *	memory ring, starting at the reader's own cursor
+ *	@note A new reader starts with its cursor at ring->head. A
+ *	reader that falls more than the capacity behind skips ahead;
+ *	the skipped samples are added to its lost count.
+ *
+ *
+ *
+ *  @param ring : The ring
+ *  @param v_cursor_u32 : The cursor of the reader
+ *  @param a_sample : Destination for the samples
+ *  @param v_max_u32 : Size of the destination
+ *  @param v_count_u32 : Number of samples copied
+ *  @param v_lost_u32 : Lost count of the reader
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> The ring is not initialized
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_shm_ring_read(
+const struct bmp280_shm_ring_t *ring, u32 *v_cursor_u32,
+struct bmp280_sample_t *a_sample, u32 v_max_u32, u32 *v_count_u32,
+u32 *v_lost_u32);
+/**************************************************************/
+/**\name	FUNCTIONS FOR SAMPLE FRAMES  */
+/**************************************************************/
+/*!
+ *	@brief This API writes a frame header
+ *
+ *
+ *
+ *  @param a_frame_u8 : The frame, BMP280_FRAME_HEADER_LEN bytes
+ *  @param v_type_u8 : BMP280_FRAME_SUBSCRIBE to _STATUS
+ *  @param v_sensor_u8 : Sensor the frame refers to
+ *  @param v_payload_len_u16 : Length of the payload that follows
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_put_header(u8 *a_frame_u8,
+u8 v_type_u8, u8 v_sensor_u8, u16 v_payload_len_u16);
+/*!
+ *	@brief This API reads a frame header and checks that the
+ *	whole payload is present
+ *
+ *
+ *
+ *  @param a_frame_u8 : The received bytes
+ *  @param v_len_u32 : Number of received bytes
+ *  @param v_type_u8 : The frame type
+ *  @param v_sensor_u8 : The sensor
+ *  @param v_payload_len_u16 : Length of the payload at
+ *	a_frame_u8 + BMP280_FRAME_HEADER_LEN
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Truncated frame
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_get_header(const u8 *a_frame_u8,
+u32 v_len_u32, u8 *v_type_u8, u8 *v_sensor_u8, u16 *v_payload_len_u16);
+/*!
+ *	@brief This API writes a complete subscribe frame of
+ *	BMP280_FRAME_HEADER_LEN + BMP280_FRAME_SUBSCRIBE_LEN bytes
+ *
+ *
+ *
+ *  @param a_frame_u8 : The frame
+ *  @param v_sensor_u8 : The sensor
+ *  @param v_period_usec_u32 : Requested sample period in us
+ *  @param v_batch_u8 : Samples per delivered frame
+ *  @param v_flags_u8 : 0 or BMP280_FRAME_FLAG_SHM
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_put_subscribe(u8 *a_frame_u8,
+u8 v_sensor_u8, u32 v_period_usec_u32, u8 v_batch_u8, u8 v_flags_u8);
+/*!
+ *	@brief This API reads the payload of a subscribe frame
+ *
+ *
+ *
+ *  @param a_payload_u8 : The payload
+ *  @param v_payload_len_u16 : Length of the payload
+ *  @param v_period_usec_u32 : Requested sample period in us
+ *  @param v_batch_u8 : Samples per delivered frame
+ *  @param v_flags_u8 : 0 or BMP280_FRAME_FLAG_SHM
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Payload too short
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_get_subscribe(
+const u8 *a_payload_u8, u16 v_payload_len_u16, u32 *v_period_usec_u32,
+u8 *v_batch_u8, u8 *v_flags_u8);
+/*!
+ *	@brief This API writes a complete shared memory ring frame of
+ *	BMP280_FRAME_HEADER_LEN + BMP280_FRAME_SHM_RING_LEN bytes; the
+ *	file descriptor of the ring travels beside it
+ *
+ *
+ *
+ *  @param a_frame_u8 : The frame
+ *  @param v_sensor_u8 : The sensor
+ *  @param v_capacity_u32 : Capacity of the ring in samples
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_put_shm_ring(u8 *a_frame_u8,
+u8 v_sensor_u8, u32 v_capacity_u32);
+/*!
+ *	@brief This API reads the payload of a shared memory ring frame
+ *
+ *
+ *
+ *  @param a_payload_u8 : The payload
+ *  @param v_payload_len_u16 : Length of the payload
+ *  @param v_capacity_u32 : Capacity of the ring in samples
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Payload too short
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_get_shm_ring(
+const u8 *a_payload_u8, u16 v_payload_len_u16, u32 *v_capacity_u32);
+/*!
+ *	@brief This API writes a complete status frame of
+ *	BMP280_FRAME_HEADER_LEN + BMP280_FRAME_STATUS_LEN bytes, the
+ *	answer to a request that has no other reply
+ *
+ *
+ *
+ *  @param a_frame_u8 : The frame
+ *  @param v_sensor_u8 : The sensor
+ *  @param v_status_s8 : 0 on success, else the error code
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_put_status(u8 *a_frame_u8,
+u8 v_sensor_u8, s8 v_status_s8);
+/*!
+ *	@brief This API reads the payload of a status frame
+ *
+ *
+ *
+ *  @param a_payload_u8 : The payload
+ *  @param v_payload_len_u16 : Length of the payload
+ *  @param v_status_s8 : 0 on success, else the error code
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Payload too short
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_get_status(
+const u8 *a_payload_u8, u16 v_payload_len_u16, s8 *v_status_s8);
+/*!
+ *	@brief This API writes a samples frame carrying a batch of
+ *	samples of one sensor
+ *	@note Each sample takes BMP280_FRAME_SAMPLE_LEN bytes, the
+ *	20 bit raw codes are packed into 5 bytes.
+ *
+ *
+ *
+ *  @param a_frame_u8 : The frame
+ *  @param v_size_u32 : Size of the frame buffer
+ *  @param v_sensor_u8 : The sensor
+ *  @param a_sample : The samples
+ *  @param v_count_u16 : Number of samples
+ *  @param v_frame_len_u32 : Length of the written frame
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> The samples do not fit
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_put_samples(u8 *a_frame_u8,
+u32 v_size_u32, u8 v_sensor_u8, const struct bmp280_sample_t *a_sample,
+u16 v_count_u16, u32 *v_frame_len_u32);
+/*!
+ *	@brief This API reads one sample of a samples frame
+ *
+ *
+ *
+ *  @param a_payload_u8 : The payload
+ *  @param v_payload_len_u16 : Length of the payload
+ *  @param v_index_u16 : Index of the sample in the frame
+ *  @param sample : The sample
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Index past the payload
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_frame_get_sample(const u8 *a_payload_u8,
+u16 v_payload_len_u16, u16 v_index_u16, struct bmp280_sample_t *sample);
+#if defined(BMP280_ENABLE_INT64) && defined(BMP280_64BITSUPPORT_PRESENT)
+/**************************************************************/
+/**\name	FUNCTIONS FOR THE SAMPLE LOG  */
+/**************************************************************/
+/*!
+ *	@brief This API returns the largest size in bytes of a log
+ *	block of v_count_u16 samples, i.e. the buffer to provide to
+ *	bmp280_log_encode_block()
+ *
+ *
+ *
+ *  @param v_count_u16 : Number of samples
+ *  @param v_size_u32 : The size
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_block_bound(u16 v_count_u16,
+u32 *v_size_u32);
+/*!
+ *	@brief This API encodes samples of one device into a log block
+ *	@note Only the raw codes, timestamps and the first sequence
+ *	number are stored; the block carries the calibration and
+ *	configuration of dev so that compensation can be done when
+ *	the log is read.
+ *	@note A typical block needs 2 to 3 bytes per sample: at osrs
+ *	x1 the four zero bits of the XLSB are stripped from the
+ *	deltas, and a steady sampling grid leaves only the timing
+ *	jitter in the delta-of-delta.
+ *
+ *
+ *
+ *  @param dev : Device the samples were taken from
+ *  @param a_sample : The samples, in time order
+ *  @param v_count_u16 : Number of samples, at least 1
+ *  @param a_block_u8 : Destination, 8 byte aligned
+ *  @param v_size_u32 : Size of the destination, see
+ *	bmp280_log_block_bound()
+ *  @param v_len_u32 : Size of the block, a multiple of
+ *	BMP280_LOG_ALIGN
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> No samples or destination too small
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_encode_block(
+const struct bmp280_t *dev, const struct bmp280_sample_t *a_sample,
+u16 v_count_u16, u8 *a_block_u8, u32 v_size_u32, u32 *v_len_u32);
+/*!
+ *	@brief This API decodes the header of a log block without
+ *	touching its payload
+ *	@note block->payload points into a_block_u8, which has to
+ *	stay valid while the block is decoded.
+ *
+ *
+ *
+ *  @param a_block_u8 : The block
+ *  @param v_len_u32 : Bytes available at a_block_u8
+ *  @param block : The decoded header
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Not a block of this version
+ *	@retval -2 -> Truncated block
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_decode_header(const u8 *a_block_u8,
+u32 v_len_u32, struct bmp280_log_block_t *block);
+/*!
+ *	@brief This API decodes the samples of a log block
+ *	@note The raw codes, timestamps and sequence numbers are
+ *	restored, the sequence counting up from the first sample; the
+ *	compensated fields and status are zero. Compensate with
+ *	bmp280_compensate_samples(&block->calib_param, ...).
+ *
+ *
+ *
+ *  @param block : Header decoded by bmp280_log_decode_header()
+ *  @param a_sample : Destination for block->count samples
+ *  @param v_max_u32 : Size of the destination
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Destination too small
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_decode_block(
+const struct bmp280_log_block_t *block, struct bmp280_sample_t *a_sample,
+u32 v_max_u32);
+/*!
+ *	@brief This API sets up a log writer collecting the samples
+ *	of dev into blocks of v_capacity_u16 samples
+ *
+ *
+ *
+ *  @param writer : The writer
+ *  @param dev : Device of the samples; its calibration and
+ *	configuration go into every block
+ *  @param a_sample : Storage for v_capacity_u16 samples
+ *  @param v_capacity_u16 : Samples per block
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Zero capacity
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_writer_init(
+struct bmp280_log_writer_t *writer, const struct bmp280_t *dev,
+struct bmp280_sample_t *a_sample, u16 v_capacity_u16);
+/*!
+ *	@brief This API closes the open block of a writer, if it
+ *	holds any sample, e.g. before shutdown or a calibration change
+ *
+ *
+ *
+ *  @param writer : The writer
+ *  @param a_block_u8 : Destination of bmp280_log_block_bound()
+ *	bytes for the writer capacity
+ *  @param v_size_u32 : Size of the destination
+ *  @param v_len_u32 : Size of the block to append, 0 if none;
+ *	writer->index then holds its index entry
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Destination too small
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_writer_flush(
+struct bmp280_log_writer_t *writer, u8 *a_block_u8, u32 v_size_u32,
+u32 *v_len_u32);
+/*!
+ *	@brief This API adds a sample to the open block of a writer;
+ *	a full block is encoded into a_block_u8
+ *
+ *
+ *
+ *  @param writer : The writer
+ *  @param sample : The sample
+ *  @param a_block_u8 : Destination of bmp280_log_block_bound()
+ *	bytes for the writer capacity
+ *  @param v_size_u32 : Size of the destination
+ *  @param v_len_u32 : Size of the block to append, 0 if none;
+ *	writer->index then holds its index entry
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -2 -> Destination too small
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_writer_push(
+struct bmp280_log_writer_t *writer, const struct bmp280_sample_t *sample,
+u8 *a_block_u8, u32 v_size_u32, u32 *v_len_u32);
+/**************************************************************/
+/**\name	FUNCTIONS FOR THE LOG INDEX  */
+/**************************************************************/
+/*!
+ *	@brief This API writes an index entry in its little endian
+ *	form of BMP280_LOG_INDEX_LEN bytes
+ *
+ *
+ *
+ *  @param index : The index entry
+ *  @param a_data_u8 : Destination of BMP280_LOG_INDEX_LEN bytes
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_index_put(
+const struct bmp280_log_index_t *index, u8 *a_data_u8);
+/*!
+ *	@brief This API reads an index entry written by
+ *	bmp280_log_index_put()
+ *
+ *
+ *
+ *  @param a_data_u8 : BMP280_LOG_INDEX_LEN bytes
+ *  @param index : The index entry
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Not an index entry
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_index_get(const u8 *a_data_u8,
+struct bmp280_log_index_t *index);
+/*!
+ *	@brief This API sets up a query matching every sample: all
+ *	time and value ranges open, all counters zero
+ *	@note Narrow the ranges afterwards. The physical ranges alone
+ *	already skip blocks when bmp280_log_query_index() gets the
+ *	calibration; the raw ranges are only needed to narrow a query
+ *	on the raw codes themselves.
+ *
+ *
+ *
+ *  @param query : The query
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_query_init(
+struct bmp280_log_query_t *query);
+/*!
+ *	@brief This API checks an index entry against the time and
+ *	raw ranges of a query, without touching the block
+ *	@note With the calibration the physical ranges are checked as
+ *	well: the temperature range of the block follows exactly from
+ *	its raw range, and its raw pressure range is compared with the
+ *	raw bounds of the pressure range from bmp280_invert_pressure()
+ *	at the t_fine of both temperature extremes.
+ *
+ *
+ *
+ *  @param query : The query
+ *  @param index : Index entry of the block
+ *  @param calib : Calibration of the device of the log, or
+ *	BMP280_NULL to check the time and raw ranges only
+ *  @param v_match_u8 : 1 if the block may hold a match, 0 if it
+ *	can be skipped
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_query_index(
+struct bmp280_log_query_t *query, const struct bmp280_log_index_t *index,
+const struct bmp280_calib_param_t *calib, u8 *v_match_u8);
+/*!
+ *	@brief This API returns the samples of a block that match a
+ *	query, compensated
+ *	@note Samples are filtered on time and raw codes first; only
+ *	those left are compensated and filtered on the physical ranges.
+ *	The matches are packed to the start of a_sample.
+ *
+ *
+ *
+ *  @param query : The query
+ *  @param index : Index entry of the block
+ *  @param block : Header decoded by bmp280_log_decode_header()
+ *  @param a_sample : Storage for block->count samples
+ *  @param v_max_u32 : Size of the storage
+ *  @param v_count_u32 : Number of matching samples
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Index entry does not describe the block
+ *	@retval -2 -> Storage too small
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_query_block(
+struct bmp280_log_query_t *query, const struct bmp280_log_index_t *index,
+const struct bmp280_log_block_t *block, struct bmp280_sample_t *a_sample,
+u32 v_max_u32, u32 *v_count_u32);
+/**************************************************************/
+/**\name	FUNCTIONS FOR THE LOG CURSOR  */
+/**************************************************************/
+/*!
+ *	@brief This API sets up a cursor over a log held in memory,
+ *	e.g. a file mapped with mmap()
+ *	@note Nothing is copied: the log has to stay mapped while the
+ *	cursor and the blocks it returns are in use.
+ *
+ *
+ *
+ *  @param cursor : The cursor
+ *  @param a_data_u8 : Start of the log
+ *  @param v_len_u64 : Bytes of the log
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_cursor_init(
+struct bmp280_log_cursor_t *cursor, const u8 *a_data_u8, u64 v_len_u64);
+/*!
+ *	@brief This API moves a cursor to the next block; only its
+ *	header is read, the samples left in the current block are
+ *	skipped without being decoded
+ *	@note cursor->block then describes the block in place.
+ *	A block cut short at the end of the log, e.g. of a file still
+ *	being written, is reported as -2; the cursor stays before it,
+ *	so the call can be repeated once the log has grown.
+ *
+ *
+ *
+ *  @param cursor : The cursor
+ *  @param v_valid_u8 : 1 if a block was entered, 0 at the end
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -1 -> Not a block of this version
+ *	@retval -2 -> Truncated block
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_cursor_next_block(
+struct bmp280_log_cursor_t *cursor, u8 *v_valid_u8);
+/*!
+ *	@brief This API decodes the next samples of the current block
+ *	of a cursor, raw as in bmp280_log_decode_block()
+ *
+ *
+ *
+ *  @param cursor : The cursor
+ *  @param a_sample : Destination
+ *  @param v_max_u32 : Size of the destination
+ *  @param v_count_u32 : Samples decoded, 0 at the end of the block
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_cursor_read(
+struct bmp280_log_cursor_t *cursor, struct bmp280_sample_t *a_sample,
+u32 v_max_u32, u32 *v_count_u32);
+/*!
+ *	@brief This API fills a_sample with the next compensated
+ *	samples of a log, crossing blocks as needed
+ *	@note Each block's samples are compensated as one batch by
+ *	bmp280_compensate_samples() with the calibration stored in
+ *	that block.
+ *
+ *
+ *
+ *  @param cursor : The cursor
+ *  @param a_sample : Destination
+ *  @param v_max_u32 : Size of the destination
+ *  @param v_count_u32 : Samples returned, 0 at the end of the log
+ *
+ *
+ *  @return results of bus communication function
+ *	@retval 0 -> Success, v_count_u32 samples returned
+ *	@retval -1 -> Not a block of this version
+ *	@retval -2 -> Truncated block after the samples returned
+ *	@retval -127 -> Null pointer
+ *
+ *
+*/
+BMP280_RETURN_FUNCTION_TYPE bmp280_log_cursor_next(
+struct bmp280_log_cursor_t *cursor, struct bmp280_sample_t *a_sample,
+u32 v_max_u32, u32 *v_count_u32);
+#endif
 #endif
@@ -52,6 +52,10 @@
 /*---------------------------------------------------------------------------*/
 /* Includes*/
 /*---------------------------------------------------------------------------*/
+#if defined(BMP280_POSIX_SUPPORT) && !defined(_GNU_SOURCE)
+/* CPU affinity of the real-time runner */
+#define _GNU_SOURCE
+#endif
 #include "bmp280.h"
 
 /*----------------------------------------------------------------------------*
@@ -440,3 +444,1857 @@ void  BMP280_delay_msek(u32 msek)
 	/*Here you can write your own delay routine*/
 }
 #endif
+
+#ifdef BMP280_POSIX_SUPPORT
+/*----------------------------------------------------------------------------*
+*  The following functions are examples for POSIX hosts (e.g. Linux) with
+*	several BMP280 on independent I2C/SPI buses.
+*	Build this part with -DBMP280_POSIX_SUPPORT and link with -lpthread
+*	(and -lrt for shm_open on older C libraries)
+*----------------------------------------------------------------------------*/
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define	BMP280_SYNC_MAX_BUS	4
+#define	BMP280_SYNC_MAX_DEV_PER_BUS	8
+/* lead time between releasing the bus threads and the common trigger */
+#define	BMP280_SYNC_LEAD_USEC	300
+#define	BMP280_SYNC_TARGET_SKEW_USEC	100
+
+/*	\Brief: Monotonic time in microseconds, wrapping at 2^32
+ *	\Return : The current time
+ */
+u32 BMP280_get_time_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u32)((u64)ts.tv_sec * 1000000 + (u64)ts.tv_nsec / 1000);
+}
+
+/* Devices of one bus and the trigger timestamps of the last round */
+struct bmp280_sync_bus_t {
+	struct bmp280_t *dev[BMP280_SYNC_MAX_DEV_PER_BUS];
+	u8 dev_count;
+	u32 trigger_usec[BMP280_SYNC_MAX_DEV_PER_BUS];
+	u32 wait_usec;
+	s8 com_rslt;
+	pthread_t thread;
+	struct bmp280_sync_t *sync;
+};
+
+/* Shared state of all bus threads */
+struct bmp280_sync_t {
+	struct bmp280_sync_bus_t bus[BMP280_SYNC_MAX_BUS];
+	u8 bus_count;
+	pthread_barrier_t start_barrier;
+	pthread_barrier_t done_barrier;
+	/* holds the bus threads until all of them are started */
+	pthread_mutex_t gate_lock;
+	pthread_cond_t gate_cond;
+	int gate_open;
+	volatile u32 start_usec;
+	volatile int stop;
+	struct bmp280_skew_stat_t skew;
+};
+
+/*	\Brief: Bus thread: released by the start barrier, it spins until
+ *	the common start time and triggers every device of its bus.
+ *	Spinning instead of sleeping keeps the wake-up latency of the
+ *	threads out of the trigger skew.
+ *	\param arg : The bus of this thread
+ */
+static void *bmp280_sync_bus_thread(void *arg)
+{
+	struct bmp280_sync_bus_t *bus = (struct bmp280_sync_bus_t *)arg;
+	struct bmp280_sync_t *sync = bus->sync;
+
+	pthread_mutex_lock(&sync->gate_lock);
+	while (!sync->gate_open)
+		pthread_cond_wait(&sync->gate_cond, &sync->gate_lock);
+	pthread_mutex_unlock(&sync->gate_lock);
+	/* a failed start never reaches the barriers */
+	if (sync->stop)
+		return NULL;
+	for (;;) {
+		pthread_barrier_wait(&sync->start_barrier);
+		if (sync->stop)
+			break;
+		while (BMP280_TIME_DIFF_USEC(BMP280_get_time_usec(),
+		sync->start_usec) < 0)
+			;
+		bus->com_rslt = bmp280_group_sync_trigger_forced(bus->dev,
+		bus->dev_count, BMP280_get_time_usec, bus->trigger_usec,
+		&bus->wait_usec);
+		pthread_barrier_wait(&sync->done_barrier);
+	}
+	return NULL;
+}
+
+/*	\Brief: Starts one thread per bus; the devices of each bus have to
+ *	be initialized and assigned to sync->bus[] before. If a thread
+ *	cannot be started, the ones already running are joined again.
+ *	\Return : 0 on success
+ *	\param sync : The synchronized sampling state
+ */
+s32 bmp280_sync_start(struct bmp280_sync_t *sync)
+{
+	u8 v_bus_u8 = BMP280_ZERO_U8X;
+	u8 v_started_u8 = BMP280_ZERO_U8X;
+
+	sync->stop = 0;
+	sync->gate_open = 0;
+	sync->skew.target_skew_usec = BMP280_SYNC_TARGET_SKEW_USEC;
+	pthread_mutex_init(&sync->gate_lock, NULL);
+	pthread_cond_init(&sync->gate_cond, NULL);
+	pthread_barrier_init(&sync->start_barrier, NULL, sync->bus_count + 1);
+	pthread_barrier_init(&sync->done_barrier, NULL, sync->bus_count + 1);
+	for (v_started_u8 = BMP280_ZERO_U8X;
+	v_started_u8 < sync->bus_count; v_started_u8++) {
+		sync->bus[v_started_u8].sync = sync;
+		if (pthread_create(&sync->bus[v_started_u8].thread, NULL,
+		bmp280_sync_bus_thread, &sync->bus[v_started_u8]))
+			break;
+	}
+	/* the barriers count every bus, so only a full start may use them */
+	if (v_started_u8 < sync->bus_count)
+		sync->stop = 1;
+	pthread_mutex_lock(&sync->gate_lock);
+	sync->gate_open = 1;
+	pthread_cond_broadcast(&sync->gate_cond);
+	pthread_mutex_unlock(&sync->gate_lock);
+	if (!sync->stop)
+		return SUCCESS;
+	for (v_bus_u8 = BMP280_ZERO_U8X; v_bus_u8 < v_started_u8; v_bus_u8++)
+		pthread_join(sync->bus[v_bus_u8].thread, NULL);
+	pthread_barrier_destroy(&sync->start_barrier);
+	pthread_barrier_destroy(&sync->done_barrier);
+	pthread_cond_destroy(&sync->gate_cond);
+	pthread_mutex_destroy(&sync->gate_lock);
+	return ERROR;
+}
+
+/*	\Brief: Triggers all buses at the same instant, waits for the longest
+ *	conversion and reads all devices. Skew statistics are kept in sync->skew
+ *	\Return : communication result
+ *	\param sync : The synchronized sampling state
+ *	\param a_uncomp_pressure_s32 : uncompensated pressure, bus major order
+ *	\param a_uncomp_temperature_s32 : uncompensated temperature, bus major order
+ */
+s32 bmp280_sync_sample(struct bmp280_sync_t *sync,
+s32 *a_uncomp_pressure_s32, s32 *a_uncomp_temperature_s32)
+{
+	u32 a_trigger_usec_u32[BMP280_SYNC_MAX_BUS * BMP280_SYNC_MAX_DEV_PER_BUS];
+	u32 v_wait_usec_u32 = BMP280_ZERO_U8X;
+	struct timespec ts;
+	s32 com_rslt = SUCCESS;
+	u8 v_count_u8 = BMP280_ZERO_U8X;
+	u8 v_bus_u8 = BMP280_ZERO_U8X;
+	u8 v_dev_u8 = BMP280_ZERO_U8X;
+
+	sync->start_usec = BMP280_get_time_usec() + BMP280_SYNC_LEAD_USEC;
+	pthread_barrier_wait(&sync->start_barrier);
+	pthread_barrier_wait(&sync->done_barrier);
+	for (v_bus_u8 = BMP280_ZERO_U8X; v_bus_u8 < sync->bus_count; v_bus_u8++) {
+		com_rslt = bmp280_first_error(com_rslt,
+		sync->bus[v_bus_u8].com_rslt);
+		if (sync->bus[v_bus_u8].wait_usec > v_wait_usec_u32)
+			v_wait_usec_u32 = sync->bus[v_bus_u8].wait_usec;
+		for (v_dev_u8 = BMP280_ZERO_U8X;
+		v_dev_u8 < sync->bus[v_bus_u8].dev_count; v_dev_u8++)
+			a_trigger_usec_u32[v_count_u8++] =
+			sync->bus[v_bus_u8].trigger_usec[v_dev_u8];
+	}
+	bmp280_sync_update_skew(a_trigger_usec_u32, v_count_u8, &sync->skew);
+
+	ts.tv_sec = 0;
+	ts.tv_nsec = (long)v_wait_usec_u32 * 1000;
+	nanosleep(&ts, NULL);
+	for (v_bus_u8 = BMP280_ZERO_U8X; v_bus_u8 < sync->bus_count; v_bus_u8++) {
+		com_rslt = bmp280_first_error(com_rslt,
+		bmp280_group_read_uncomp_pressure_temperature(
+		sync->bus[v_bus_u8].dev, sync->bus[v_bus_u8].dev_count,
+		a_uncomp_pressure_s32, a_uncomp_temperature_s32));
+		a_uncomp_pressure_s32 += sync->bus[v_bus_u8].dev_count;
+		a_uncomp_temperature_s32 += sync->bus[v_bus_u8].dev_count;
+	}
+	return com_rslt;
+}
+
+/*	\Brief: Stops and joins the bus threads
+ *	\param sync : The synchronized sampling state
+ */
+void bmp280_sync_stop(struct bmp280_sync_t *sync)
+{
+	u8 v_bus_u8 = BMP280_ZERO_U8X;
+
+	sync->stop = 1;
+	pthread_barrier_wait(&sync->start_barrier);
+	for (v_bus_u8 = BMP280_ZERO_U8X; v_bus_u8 < sync->bus_count; v_bus_u8++)
+		pthread_join(sync->bus[v_bus_u8].thread, NULL);
+	pthread_barrier_destroy(&sync->start_barrier);
+	pthread_barrier_destroy(&sync->done_barrier);
+	pthread_cond_destroy(&sync->gate_cond);
+	pthread_mutex_destroy(&sync->gate_lock);
+}
+
+/*	\Brief: Arms a timerfd with an absolute CLOCK_MONOTONIC expiry
+ *	given as a wrapping microsecond deadline
+ *	\Return : result of timerfd_settime
+ *	\param timer_fd : The timerfd
+ *	\param v_deadline_usec_u32 : The deadline in us
+ */
+static int bmp280_timerfd_arm(int timer_fd, u32 v_deadline_usec_u32)
+{
+	struct itimerspec its = {{0, 0}, {0, 0}};
+	struct timespec now;
+	s32 v_wait_s32 = BMP280_TIME_DIFF_USEC(v_deadline_usec_u32,
+	BMP280_get_time_usec());
+	u64 v_ns_u64 = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	/* an all zero it_value would disarm the timer */
+	if (v_wait_s32 < 1)
+		v_wait_s32 = 1;
+	v_ns_u64 = (u64)now.tv_nsec + (u64)v_wait_s32 * 1000;
+	its.it_value.tv_sec = now.tv_sec + (time_t)(v_ns_u64 / 1000000000);
+	its.it_value.tv_nsec = (long)(v_ns_u64 % 1000000000);
+	return timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &its, NULL);
+}
+
+/*	\Brief: Event loop of one acquisition thread: all sensors of the engine
+ *	share a single timerfd that is always armed with the earliest deadline,
+ *	and the thread sleeps in epoll_wait in between. stop_fd (e.g. an
+ *	eventfd) ends the loop when it becomes readable. Samples are delivered
+ *	through the sample_cb of each struct bmp280_async_t.
+ *	\Return : communication result
+ *	\param engine : The engine holding the sensors of this thread
+ *	\param stop_fd : File descriptor that ends the loop, -1 for none
+ */
+s32 bmp280_engine_epoll_loop(struct bmp280_engine_t *engine, int stop_fd)
+{
+	struct epoll_event ev;
+	struct epoll_event events[2];
+	u64 v_expirations_u64 = 0;
+	u32 v_deadline_u32 = BMP280_ZERO_U8X;
+	s32 com_rslt = SUCCESS;
+	int timer_fd = -1;
+	int epoll_fd = -1;
+	int v_ready = 0;
+	int v_index = 0;
+	int v_run = 1;
+
+	timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (timer_fd < 0 || epoll_fd < 0)
+		v_run = 0;
+	ev.events = EPOLLIN;
+	ev.data.fd = timer_fd;
+	if (v_run)
+		epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev);
+	if (v_run && stop_fd >= 0) {
+		ev.data.fd = stop_fd;
+		epoll_ctl(epoll_fd, EPOLL_CTL_ADD, stop_fd, &ev);
+	}
+	while (v_run) {
+		if (bmp280_engine_next_deadline(engine, &v_deadline_u32) == SUCCESS)
+			bmp280_timerfd_arm(timer_fd, v_deadline_u32);
+		v_ready = epoll_wait(epoll_fd, events, 2, -1);
+		for (v_index = 0; v_index < v_ready; v_index++) {
+			if (events[v_index].data.fd == stop_fd) {
+				v_run = 0;
+			} else if (read(timer_fd, &v_expirations_u64,
+			sizeof(v_expirations_u64)) > 0) {
+				com_rslt = bmp280_first_error(com_rslt,
+				bmp280_engine_run(engine,
+				BMP280_get_time_usec()));
+			}
+		}
+	}
+	if (epoll_fd >= 0)
+		close(epoll_fd);
+	if (timer_fd >= 0)
+		close(timer_fd);
+	return com_rslt;
+}
+
+#define	BMP280_WS_MAX_BUS	8
+#define	BMP280_WS_MAX_WORKER	16
+#define	BMP280_WS_MAX_DEV_PER_BUS	32
+/* deque and task slots per bus, a power of two */
+#define	BMP280_WS_DEQUE_SIZE	64
+#define	BMP280_WS_DEQUE_MASK	(BMP280_WS_DEQUE_SIZE - 1)
+/* sleep of a worker that found nothing to steal */
+#define	BMP280_WS_IDLE_USEC	50
+
+struct bmp280_ws_worker_t;
+
+/* One unit of work: a sweep of a bus to compensate, or any
+ * follow-up work spawned by a worker (e.g. filtering) */
+struct bmp280_ws_task_t {
+	void (*run)(struct bmp280_ws_worker_t *worker,
+	struct bmp280_ws_task_t *task);
+	struct bmp280_ws_bus_t *bus;
+	struct bmp280_sample_t sample[BMP280_WS_MAX_DEV_PER_BUS];
+	u8 count;
+	volatile int busy;
+	void *user_data;
+};
+
+/* Chase-Lev deque: the owner pushes and pops at the bottom,
+ * thieves take from the top */
+struct bmp280_ws_deque_t {
+	volatile long top;
+	u8 pad_top[BMP280_CACHE_LINE_SIZE - sizeof(long)];
+	volatile long bottom;
+	u8 pad_bottom[BMP280_CACHE_LINE_SIZE - sizeof(long)];
+	struct bmp280_ws_task_t *volatile slot[BMP280_WS_DEQUE_SIZE];
+};
+
+/* A bus and its I/O thread; the thread never compensates. A sweep
+ * that fails, or finds every task slot of the bus still queued, is
+ * dropped and counted in overrun_count */
+struct bmp280_ws_bus_t {
+	struct bmp280_t *dev[BMP280_WS_MAX_DEV_PER_BUS];
+	u8 dev_count;
+	u32 interval_usec;
+	u32 sweep_count;
+	u32 overrun_count;
+	pthread_t thread;
+	struct bmp280_ws_deque_t deque;
+	struct bmp280_ws_task_t task[BMP280_WS_DEQUE_SIZE];
+	u32 next_task;
+	struct bmp280_ws_pool_t *pool;
+};
+
+struct bmp280_ws_worker_t {
+	pthread_t thread;
+	struct bmp280_ws_deque_t deque;
+	struct bmp280_ws_pool_t *pool;
+	u32 task_count;
+	u32 steal_count;
+	unsigned int seed;
+};
+
+/* Pinned bus threads plus a pool of compensation workers */
+struct bmp280_ws_pool_t {
+	struct bmp280_ws_bus_t bus[BMP280_WS_MAX_BUS];
+	u8 bus_count;
+	struct bmp280_ws_worker_t worker[BMP280_WS_MAX_WORKER];
+	u8 worker_count;
+	volatile int running;
+	/* called by a worker for every compensated sample */
+	void (*sample_cb)(struct bmp280_ws_worker_t *worker,
+	struct bmp280_t *dev, const struct bmp280_sample_t *sample);
+};
+
+/*	\Brief: Pushes a task at the bottom, owner only
+ *	\Return : 0 on success, -1 when the deque is full
+ */
+static int bmp280_ws_push(struct bmp280_ws_deque_t *deque,
+struct bmp280_ws_task_t *task)
+{
+	long b = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
+	long t = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+
+	if (b - t >= BMP280_WS_DEQUE_SIZE)
+		return -1;
+	__atomic_store_n(&deque->slot[b & BMP280_WS_DEQUE_MASK], task,
+	__ATOMIC_RELAXED);
+	__atomic_store_n(&deque->bottom, b + 1, __ATOMIC_RELEASE);
+	return 0;
+}
+
+/*	\Brief: Pops the newest task, owner only
+ *	\Return : The task or NULL
+ */
+static struct bmp280_ws_task_t *bmp280_ws_pop(
+struct bmp280_ws_deque_t *deque)
+{
+	struct bmp280_ws_task_t *task = NULL;
+	long b = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) - 1;
+	long t = 0;
+
+	__atomic_store_n(&deque->bottom, b, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	t = __atomic_load_n(&deque->top, __ATOMIC_RELAXED);
+	if (t <= b) {
+		task = __atomic_load_n(&deque->slot[b & BMP280_WS_DEQUE_MASK],
+		__ATOMIC_RELAXED);
+		if (t == b) {
+			/* last task: race the thieves for it */
+			if (!__atomic_compare_exchange_n(&deque->top, &t, t + 1,
+			0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+				task = NULL;
+			__atomic_store_n(&deque->bottom, b + 1,
+			__ATOMIC_RELAXED);
+		}
+	} else {
+		__atomic_store_n(&deque->bottom, b + 1, __ATOMIC_RELAXED);
+	}
+	return task;
+}
+
+/*	\Brief: Takes the oldest task, any thread
+ *	\Return : The task or NULL when empty or lost to another thief
+ */
+static struct bmp280_ws_task_t *bmp280_ws_steal(
+struct bmp280_ws_deque_t *deque)
+{
+	struct bmp280_ws_task_t *task = NULL;
+	long t = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+	long b = 0;
+
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	b = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+	if (t < b) {
+		task = __atomic_load_n(&deque->slot[t & BMP280_WS_DEQUE_MASK],
+		__ATOMIC_RELAXED);
+		if (!__atomic_compare_exchange_n(&deque->top, &t, t + 1,
+		0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+			task = NULL;
+	}
+	return task;
+}
+
+/*	\Brief: Spawns follow-up work (e.g. filtering) from inside a task;
+ *	it runs on this worker unless an idle worker steals it first
+ *	\Return : 0 on success, -1 when the deque is full
+ *	\param worker : The worker running the current task
+ *	\param task : The task, owned by the caller until run returns
+ */
+int bmp280_ws_spawn(struct bmp280_ws_worker_t *worker,
+struct bmp280_ws_task_t *task)
+{
+	return bmp280_ws_push(&worker->deque, task);
+}
+
+/*	\Brief: Task body of a bus sweep: compensates every sample with the
+ *	calibration of its device and hands it to the sample callback
+ */
+static void bmp280_ws_compensate(struct bmp280_ws_worker_t *worker,
+struct bmp280_ws_task_t *task)
+{
+	struct bmp280_ws_pool_t *pool = worker->pool;
+	u8 v_dev_u8 = BMP280_ZERO_U8X;
+
+	for (v_dev_u8 = BMP280_ZERO_U8X; v_dev_u8 < task->count; v_dev_u8++) {
+		bmp280_compensate_samples(&task->bus->dev[v_dev_u8]->calib_param,
+		&task->sample[v_dev_u8], BMP280_ONE_U8X);
+		if (pool->sample_cb != NULL)
+			pool->sample_cb(worker, task->bus->dev[v_dev_u8],
+			&task->sample[v_dev_u8]);
+	}
+	/* the bus thread may reuse the slot from now on */
+	__atomic_store_n(&task->busy, 0, __ATOMIC_RELEASE);
+}
+
+/*	\Brief: Bus thread: triggers, waits for and reads all devices of its
+ *	bus in forced mode every interval_usec and queues the raw sweep.
+ *	Only this thread talks to the bus, so transfers keep their order.
+ *	\param arg : The bus of this thread
+ */
+static void *bmp280_ws_bus_thread(void *arg)
+{
+	struct bmp280_ws_bus_t *bus = (struct bmp280_ws_bus_t *)arg;
+	struct bmp280_ws_task_t *task = NULL;
+	s32 a_uncomp_pressure_s32[BMP280_WS_MAX_DEV_PER_BUS];
+	s32 a_uncomp_temperature_s32[BMP280_WS_MAX_DEV_PER_BUS];
+	u32 v_next_usec_u32 = BMP280_get_time_usec();
+	u32 v_trigger_usec_u32 = BMP280_ZERO_U8X;
+	s32 v_wait_s32 = BMP280_ZERO_U8X;
+	s8 com_rslt = SUCCESS;
+	u8 v_dev_u8 = BMP280_ZERO_U8X;
+
+	while (bus->pool->running) {
+		v_trigger_usec_u32 = BMP280_get_time_usec();
+		com_rslt = bmp280_group_get_forced_uncomp_pressure_temperature(
+		bus->dev, bus->dev_count, a_uncomp_pressure_s32,
+		a_uncomp_temperature_s32);
+		task = &bus->task[bus->next_task & BMP280_WS_DEQUE_MASK];
+		if (com_rslt != SUCCESS ||
+		__atomic_load_n(&task->busy, __ATOMIC_ACQUIRE)) {
+			/* the workers are behind by a whole deque */
+			bus->overrun_count++;
+		} else {
+			bus->next_task++;
+			bus->sweep_count++;
+			task->run = bmp280_ws_compensate;
+			task->bus = bus;
+			task->count = bus->dev_count;
+			for (v_dev_u8 = BMP280_ZERO_U8X;
+			v_dev_u8 < bus->dev_count; v_dev_u8++) {
+				task->sample[v_dev_u8].uncomp_pressure =
+				a_uncomp_pressure_s32[v_dev_u8];
+				task->sample[v_dev_u8].uncomp_temperature =
+				a_uncomp_temperature_s32[v_dev_u8];
+				task->sample[v_dev_u8].timestamp_usec =
+				v_trigger_usec_u32;
+				task->sample[v_dev_u8].seq = bus->sweep_count;
+				task->sample[v_dev_u8].status = BMP280_ZERO_U8X;
+			}
+			task->busy = 1;
+			/* cannot fail, there are as many slots as tasks */
+			bmp280_ws_push(&bus->deque, task);
+		}
+		v_next_usec_u32 += bus->interval_usec;
+		v_wait_s32 = BMP280_TIME_DIFF_USEC(v_next_usec_u32,
+		BMP280_get_time_usec());
+		if (v_wait_s32 > 0)
+			usleep((useconds_t)v_wait_s32);
+		else
+			v_next_usec_u32 = BMP280_get_time_usec();
+	}
+	return NULL;
+}
+
+/*	\Brief: Worker thread: runs its own tasks first, then steals from
+ *	a random bus or worker, and naps briefly when there is nothing to do
+ *	\param arg : The worker of this thread
+ */
+static void *bmp280_ws_worker_thread(void *arg)
+{
+	struct bmp280_ws_worker_t *worker = (struct bmp280_ws_worker_t *)arg;
+	struct bmp280_ws_pool_t *pool = worker->pool;
+	struct bmp280_ws_task_t *task = NULL;
+	u8 v_victims_u8 = pool->bus_count + pool->worker_count;
+	u8 v_start_u8 = BMP280_ZERO_U8X;
+	u8 v_index_u8 = BMP280_ZERO_U8X;
+	u8 v_victim_u8 = BMP280_ZERO_U8X;
+
+	while (pool->running) {
+		task = bmp280_ws_pop(&worker->deque);
+		if (task == NULL) {
+			v_start_u8 = (u8)(rand_r(&worker->seed) % v_victims_u8);
+			for (v_index_u8 = BMP280_ZERO_U8X; task == NULL &&
+			v_index_u8 < v_victims_u8; v_index_u8++) {
+				v_victim_u8 = (u8)((v_start_u8 + v_index_u8) %
+				v_victims_u8);
+				if (v_victim_u8 < pool->bus_count)
+					task = bmp280_ws_steal(
+					&pool->bus[v_victim_u8].deque);
+				else if (&pool->worker[v_victim_u8 -
+				pool->bus_count] != worker)
+					task = bmp280_ws_steal(&pool->worker[
+					v_victim_u8 - pool->bus_count].deque);
+			}
+			if (task != NULL)
+				worker->steal_count++;
+		}
+		if (task != NULL) {
+			task->run(worker, task);
+			worker->task_count++;
+		} else {
+			usleep(BMP280_WS_IDLE_USEC);
+		}
+	}
+	return NULL;
+}
+
+/*	\Brief: Stops the threads and joins the first v_worker_u8 workers and
+ *	v_bus_u8 bus threads, i.e. those that were created
+ *	\param pool : The scheduler
+ */
+static void bmp280_ws_join(struct bmp280_ws_pool_t *pool, u8 v_worker_u8,
+u8 v_bus_u8)
+{
+	u8 v_index_u8 = BMP280_ZERO_U8X;
+
+	pool->running = 0;
+	for (v_index_u8 = BMP280_ZERO_U8X; v_index_u8 < v_bus_u8; v_index_u8++)
+		pthread_join(pool->bus[v_index_u8].thread, NULL);
+	for (v_index_u8 = BMP280_ZERO_U8X; v_index_u8 < v_worker_u8;
+	v_index_u8++)
+		pthread_join(pool->worker[v_index_u8].thread, NULL);
+}
+
+/*	\Brief: Starts the workers and one I/O thread per bus; the devices of
+ *	each bus, interval_usec, worker_count and sample_cb have to be set.
+ *	If a thread cannot be created, those already started are stopped
+ *	and joined, and bmp280_ws_stop() must not be called.
+ *	\Return : 0 on success
+ *	\param pool : The scheduler
+ */
+s32 bmp280_ws_start(struct bmp280_ws_pool_t *pool)
+{
+	u8 v_worker_u8 = BMP280_ZERO_U8X;
+	u8 v_bus_u8 = BMP280_ZERO_U8X;
+
+	pool->running = 1;
+	for (v_worker_u8 = BMP280_ZERO_U8X; v_worker_u8 < pool->worker_count;
+	v_worker_u8++) {
+		pool->worker[v_worker_u8].pool = pool;
+		pool->worker[v_worker_u8].seed = v_worker_u8 + 1;
+		if (pthread_create(&pool->worker[v_worker_u8].thread, NULL,
+		bmp280_ws_worker_thread, &pool->worker[v_worker_u8])) {
+			bmp280_ws_join(pool, v_worker_u8, BMP280_ZERO_U8X);
+			return ERROR;
+		}
+	}
+	for (v_bus_u8 = BMP280_ZERO_U8X; v_bus_u8 < pool->bus_count;
+	v_bus_u8++) {
+		pool->bus[v_bus_u8].pool = pool;
+		if (pthread_create(&pool->bus[v_bus_u8].thread, NULL,
+		bmp280_ws_bus_thread, &pool->bus[v_bus_u8])) {
+			bmp280_ws_join(pool, v_worker_u8, v_bus_u8);
+			return ERROR;
+		}
+	}
+	return SUCCESS;
+}
+
+/*	\Brief: Stops and joins all threads; sweeps still queued are dropped
+ *	\param pool : The scheduler
+ */
+void bmp280_ws_stop(struct bmp280_ws_pool_t *pool)
+{
+	bmp280_ws_join(pool, pool->worker_count, pool->bus_count);
+}
+
+/* stack pre-faulted before the real-time loop starts */
+#define	BMP280_RT_PREFAULT_STACK	(64 * 1024)
+
+/* Real-time acquisition of one device on a fixed grid */
+struct bmp280_rt_t {
+	struct bmp280_t *dev;
+	u32 period_usec;
+	/* 0 keeps the scheduling policy, else the SCHED_FIFO priority */
+	int fifo_priority;
+	/* -1 keeps the affinity, else the CPU to pin the thread to */
+	int cpu;
+	/* lock all current and future pages when not 0 */
+	int lock_memory;
+	struct bmp280_sample_t *sample;
+	u32 sample_count;
+	/* samples stored, a failed slot leaves none */
+	u32 stored_count;
+	struct bmp280_jitter_stat_t jitter;
+};
+
+/*	\Brief: Adds microseconds to a timespec */
+static void bmp280_timespec_add_usec(struct timespec *ts, u32 v_usec_u32)
+{
+	ts->tv_sec += v_usec_u32 / 1000000;
+	ts->tv_nsec += (long)(v_usec_u32 % 1000000) * 1000;
+	if (ts->tv_nsec >= 1000000000) {
+		ts->tv_nsec -= 1000000000;
+		ts->tv_sec++;
+	}
+}
+
+/*	\Brief: Makes the calling thread real-time: SCHED_FIFO, CPU pinning,
+ *	locked memory and a pre-faulted stack and sample buffer, so that
+ *	no page fault or migration happens inside the sampling loop
+ *	\Return : 0 on success
+ *	\param rt : The runner
+ */
+static s32 bmp280_rt_prepare(struct bmp280_rt_t *rt)
+{
+	volatile u8 a_stack_u8[BMP280_RT_PREFAULT_STACK];
+	struct sched_param param;
+	cpu_set_t cpus;
+	s32 com_rslt = SUCCESS;
+
+	if (rt->lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE))
+		com_rslt = ERROR;
+	memset((void *)a_stack_u8, 0, sizeof(a_stack_u8));
+	memset(rt->sample, 0, rt->sample_count * sizeof(*rt->sample));
+	if (rt->cpu >= 0) {
+		CPU_ZERO(&cpus);
+		CPU_SET(rt->cpu, &cpus);
+		if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus))
+			com_rslt = ERROR;
+	}
+	if (rt->fifo_priority > 0) {
+		param.sched_priority = rt->fifo_priority;
+		if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param))
+			com_rslt = ERROR;
+	}
+	return com_rslt;
+}
+
+/*	\Brief: Sleeps until an absolute CLOCK_MONOTONIC time, resuming after
+ *	signals; clock_nanosleep returns the error instead of setting errno
+ *	\Return : 0 on success
+ */
+static s32 bmp280_rt_sleep_until(const struct timespec *ts)
+{
+	int v_err = 0;
+
+	do {
+		v_err = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, ts,
+		NULL);
+	} while (v_err == EINTR);
+	return v_err ? ERROR : SUCCESS;
+}
+
+/*	\Brief: Takes sample_count forced measurements of rt->dev on an
+ *	absolute grid of period_usec using clock_nanosleep(TIMER_ABSTIME),
+ *	so wake-up delays never accumulate. Each sample is stamped with its
+ *	grid time plus the offset measured right at its trigger, and the
+ *	offsets are kept in rt->jitter. A missed slot is not made up for:
+ *	the next trigger waits for the next grid time, and the slots passed
+ *	over are counted in rt->jitter.skip_count. A slot whose trigger or
+ *	read fails stores no sample; the samples stored are packed at the
+ *	start of rt->sample, stored_count of them, with seq the number of
+ *	the measurement.
+ *	\Return : communication result, ERROR if a real-time setting or a
+ *	sleep failed
+ *	\param rt : The runner
+ */
+s32 bmp280_rt_run(struct bmp280_rt_t *rt)
+{
+	struct bmp280_t *a_dev[1];
+	struct bmp280_sample_t *sample = NULL;
+	struct timespec next;
+	struct timespec ready;
+	s32 v_uncomp_pressure_s32 = BMP280_ZERO_U8X;
+	s32 v_uncomp_temperature_s32 = BMP280_ZERO_U8X;
+	u32 v_planned_usec_u32 = BMP280_ZERO_U8X;
+	u32 v_actual_usec_u32 = BMP280_ZERO_U8X;
+	u32 v_wait_usec_u32 = BMP280_ZERO_U8X;
+	u32 v_index_u32 = BMP280_ZERO_U8X;
+	s32 com_rslt = SUCCESS;
+	s8 v_rslt_s8 = SUCCESS;
+
+	com_rslt = bmp280_rt_prepare(rt);
+	rt->stored_count = 0;
+	a_dev[0] = rt->dev;
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	bmp280_timespec_add_usec(&next, rt->period_usec);
+	v_planned_usec_u32 = BMP280_get_time_usec() + rt->period_usec;
+	for (v_index_u32 = 0; v_index_u32 < rt->sample_count; v_index_u32++) {
+		if (bmp280_rt_sleep_until(&next) != SUCCESS)
+			return bmp280_first_error(com_rslt, ERROR);
+		v_actual_usec_u32 = BMP280_get_time_usec();
+		v_rslt_s8 = bmp280_group_trigger_forced(a_dev, 1,
+		&v_wait_usec_u32);
+		bmp280_jitter_update(&rt->jitter, v_planned_usec_u32,
+		v_actual_usec_u32);
+		if (v_rslt_s8 == SUCCESS) {
+			ready = next;
+			bmp280_timespec_add_usec(&ready, (u32)
+			(rt->jitter.last_jitter_usec > 0 ?
+			rt->jitter.last_jitter_usec : 0) + v_wait_usec_u32);
+			if (bmp280_rt_sleep_until(&ready) != SUCCESS)
+				return bmp280_first_error(com_rslt, ERROR);
+			v_rslt_s8 =
+			bmp280_group_read_uncomp_pressure_temperature(a_dev, 1,
+			&v_uncomp_pressure_s32, &v_uncomp_temperature_s32);
+		}
+		com_rslt = bmp280_first_error(com_rslt, v_rslt_s8);
+		if (v_rslt_s8 == SUCCESS) {
+			sample = &rt->sample[rt->stored_count++];
+			sample->uncomp_pressure = v_uncomp_pressure_s32;
+			sample->uncomp_temperature = v_uncomp_temperature_s32;
+			sample->timestamp_usec = v_planned_usec_u32 +
+			(u32)rt->jitter.last_jitter_usec;
+			sample->seq = v_index_u32;
+			sample->status = BMP280_ZERO_U8X;
+			bmp280_compensate_samples(&rt->dev->calib_param,
+			sample, 1);
+		}
+		/* stay on the grid, skipping slots that are already gone */
+		bmp280_timespec_add_usec(&next, rt->period_usec);
+		v_planned_usec_u32 += rt->period_usec;
+		while (BMP280_TIME_DIFF_USEC(v_planned_usec_u32,
+		BMP280_get_time_usec()) < 0) {
+			bmp280_timespec_add_usec(&next, rt->period_usec);
+			v_planned_usec_u32 += rt->period_usec;
+			rt->jitter.skip_count++;
+		}
+	}
+	return com_rslt;
+}
+
+/* waits shorter than this are spun completely */
+#define	BMP280_DELAY_SPIN_MIN_USEC	50
+/* initial and largest spin reserve after the OS sleep */
+#define	BMP280_DELAY_SPIN_INIT_USEC	100
+#define	BMP280_DELAY_SPIN_MAX_USEC	2000
+/* weight of a new oversleep sample, as a right shift */
+#define	BMP280_DELAY_SPIN_GAIN_SHIFT	3
+
+/* spin reserve, calibrated from the observed oversleep of the OS; per
+ * thread, as the sync and bus threads each delay on their own */
+static __thread u32 bmp280_delay_spin_usec = BMP280_DELAY_SPIN_INIT_USEC;
+/* end of each delay of the calling thread against its target */
+__thread struct bmp280_jitter_stat_t bmp280_delay_overshoot;
+
+/*	\Brief: Hybrid microsecond delay for bmp280_t.delay_usec: sleeps with
+ *	clock_nanosleep(TIMER_ABSTIME) until a spin reserve before the target
+ *	and busy-spins the rest. The reserve follows the measured oversleep of
+ *	the sleep, so the CPU only spins as long as the OS needs. The final
+ *	overshoot of every delay is kept in bmp280_delay_overshoot. Reserve
+ *	and overshoot are kept per thread, so concurrent callers do not race.
+ *	\param v_usec_u32 : The delay in us
+ */
+void BMP280_delay_usec(u32 v_usec_u32)
+{
+	struct timespec wake;
+	u32 v_target_usec_u32 = BMP280_get_time_usec() + v_usec_u32;
+	u32 v_sleep_usec_u32 = BMP280_ZERO_U8X;
+	s32 v_over_s32 = BMP280_ZERO_U8X;
+
+	if (v_usec_u32 > bmp280_delay_spin_usec + BMP280_DELAY_SPIN_MIN_USEC) {
+		v_sleep_usec_u32 = v_usec_u32 - bmp280_delay_spin_usec;
+		clock_gettime(CLOCK_MONOTONIC, &wake);
+		bmp280_timespec_add_usec(&wake, v_sleep_usec_u32);
+		/* a failed sleep leaves the whole wait to the spin below */
+		if (bmp280_rt_sleep_until(&wake) != SUCCESS)
+			v_sleep_usec_u32 = BMP280_ZERO_U8X;
+	}
+	if (v_sleep_usec_u32 != BMP280_ZERO_U8X) {
+		/* oversleep of this wake-up, relative to the sleep target */
+		v_over_s32 = BMP280_TIME_DIFF_USEC(BMP280_get_time_usec(),
+		v_target_usec_u32 - bmp280_delay_spin_usec);
+		if (v_over_s32 < 0)
+			v_over_s32 = 0;
+		/* keep twice the oversleep in reserve */
+		v_over_s32 = 2 * v_over_s32 - (s32)bmp280_delay_spin_usec;
+		bmp280_delay_spin_usec = (u32)((s32)bmp280_delay_spin_usec +
+		(v_over_s32 >> BMP280_DELAY_SPIN_GAIN_SHIFT));
+		if (bmp280_delay_spin_usec < BMP280_DELAY_SPIN_MIN_USEC)
+			bmp280_delay_spin_usec = BMP280_DELAY_SPIN_MIN_USEC;
+		if (bmp280_delay_spin_usec > BMP280_DELAY_SPIN_MAX_USEC)
+			bmp280_delay_spin_usec = BMP280_DELAY_SPIN_MAX_USEC;
+	}
+	while (BMP280_TIME_DIFF_USEC(BMP280_get_time_usec(),
+	v_target_usec_u32) < 0)
+		;
+	bmp280_jitter_update(&bmp280_delay_overshoot, v_target_usec_u32,
+	BMP280_get_time_usec());
+}
+
+/*	\Brief: Creates the latest sample table as a POSIX shared memory
+ *	object, for the single acquisition process that writes it
+ *	\Return : The mapped table, NULL on failure
+ *	\param name : Name of the object, e.g. "/bmp280_latest"
+ *	\param v_count_u8 : Number of sensor slots
+ */
+struct bmp280_latest_table_t *bmp280_latest_shm_create(const char *name,
+u8 v_count_u8)
+{
+	struct bmp280_latest_table_t *table = NULL;
+	void *map = MAP_FAILED;
+	int fd = -1;
+
+	fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+	if (fd < 0)
+		return NULL;
+	if (ftruncate(fd, sizeof(*table)) == 0)
+		map = mmap(NULL, sizeof(*table), PROT_READ | PROT_WRITE,
+		MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return NULL;
+	table = (struct bmp280_latest_table_t *)map;
+	if (bmp280_latest_table_init(table, v_count_u8) != SUCCESS) {
+		munmap(map, sizeof(*table));
+		return NULL;
+	}
+	return table;
+}
+
+/*	\Brief: Maps the latest sample table of the acquisition process read
+ *	only; any number of processes may do so and read it with
+ *	bmp280_latest_read() without a system call per sample
+ *	\Return : The mapped table, NULL if missing or not initialized
+ *	\param name : Name of the object
+ */
+const struct bmp280_latest_table_t *bmp280_latest_shm_open(const char *name)
+{
+	const struct bmp280_latest_table_t *table = NULL;
+	struct stat v_stat;
+	void *map = MAP_FAILED;
+	int fd = -1;
+
+	fd = shm_open(name, O_RDONLY, 0);
+	if (fd < 0)
+		return NULL;
+	/* an object created but not yet sized by the writer would fault
+	 * on the first access to the mapping */
+	if (fstat(fd, &v_stat) || v_stat.st_size < (off_t)sizeof(*table)) {
+		close(fd);
+		return NULL;
+	}
+	map = mmap(NULL, sizeof(*table), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return NULL;
+	table = (const struct bmp280_latest_table_t *)map;
+	if (table->magic != BMP280_LATEST_MAGIC) {
+		munmap(map, sizeof(*table));
+		return NULL;
+	}
+	return table;
+}
+
+/*	\Brief: Sample callback for the acquisition engine that publishes each
+ *	sample to the slot given in async->user_data, e.g.
+ *	async->user_data = &table->slot[n]; failed reads leave the slot as it
+ *	is, so readers see its timestamp age
+ *	\param async : The sensor
+ *	\param sample : The sample, NULL on a failed read
+ *	\param v_rslt_s8 : Communication result of the read
+ */
+void bmp280_latest_sample_cb(struct bmp280_async_t *async,
+const struct bmp280_sample_t *sample, s8 v_rslt_s8)
+{
+	if (sample != NULL && v_rslt_s8 == SUCCESS)
+		bmp280_latest_write((struct bmp280_latest_t *)async->user_data,
+		sample);
+}
+
+#define	BMP280_DAEMON_MAX_SENSOR	8
+#define	BMP280_DAEMON_MAX_CLIENT	64
+/* samples kept per sensor for the socket clients */
+#define	BMP280_DAEMON_HUB_SIZE	256
+/* samples of the shared memory ring of a sensor */
+#define	BMP280_DAEMON_SHM_SIZE	4096
+/* largest batch of one samples frame */
+#define	BMP280_DAEMON_BATCH_MAX	64
+#define	BMP280_DAEMON_FRAME_LEN	(BMP280_FRAME_HEADER_LEN +\
+	BMP280_DAEMON_BATCH_MAX * BMP280_FRAME_SAMPLE_LEN)
+/* epoll tags, clients follow BMP280_DAEMON_EV_CLIENT */
+#define	BMP280_DAEMON_EV_LISTEN	0
+#define	BMP280_DAEMON_EV_TIMER	1
+#define	BMP280_DAEMON_EV_STOP	2
+#define	BMP280_DAEMON_EV_CLIENT	3
+
+/* One sensor of the daemon: its engine entry, the hub feeding the socket
+ * clients and the shared memory ring of the high-rate clients */
+struct bmp280_daemon_sensor_t {
+	struct bmp280_async_t async;
+	struct bmp280_hub_t hub;
+	struct bmp280_sample_t hub_buffer[BMP280_DAEMON_HUB_SIZE];
+	struct bmp280_hub_sub_t *hub_sub[BMP280_DAEMON_MAX_CLIENT];
+	struct bmp280_shm_ring_t *shm;
+	u32 shm_size;
+	int shm_fd;
+	u8 running;
+};
+
+/* One connected client, fd is -1 for a free entry */
+struct bmp280_daemon_client_t {
+	struct bmp280_hub_sub_t sub;
+	int fd;
+	u8 sensor;
+	u8 batch;
+	u8 subscribed;
+	/* reads the shared memory ring instead of samples frames */
+	u8 shm;
+	/* samples not delivered because the socket was full */
+	u32 drop_count;
+};
+
+/* Sampling daemon: owns the sensors, samples each once at the fastest
+ * rate requested and serves the clients of a Unix domain socket */
+struct bmp280_daemon_t {
+	struct bmp280_daemon_sensor_t sensor[BMP280_DAEMON_MAX_SENSOR];
+	u8 sensor_count;
+	struct bmp280_engine_t engine;
+	struct bmp280_async_t *heap[BMP280_DAEMON_MAX_SENSOR];
+	struct bmp280_daemon_client_t client[BMP280_DAEMON_MAX_CLIENT];
+	int listen_fd;
+	int epoll_fd;
+	int timer_fd;
+};
+
+/*	\Brief: Engine callback of the daemon; the hub of the sensor is fed
+ *	by the engine itself, the shared memory ring here
+ */
+static void bmp280_daemon_sample_cb(struct bmp280_async_t *async,
+const struct bmp280_sample_t *sample, s8 v_rslt_s8)
+{
+	struct bmp280_daemon_sensor_t *sensor =
+	(struct bmp280_daemon_sensor_t *)async->user_data;
+
+	if (sample != NULL && v_rslt_s8 == SUCCESS && sensor->shm != NULL)
+		bmp280_shm_ring_publish(sensor->shm, sample);
+}
+
+/*	\Brief: Starts, retimes or stops the sampling of a sensor after its
+ *	subscriptions changed; it runs at the hub period, i.e. the fastest
+ *	rate any client asked for
+ */
+static void bmp280_daemon_update_sensor(struct bmp280_daemon_t *daemon,
+struct bmp280_daemon_sensor_t *sensor)
+{
+	if (sensor->hub.count == 0) {
+		if (sensor->running)
+			bmp280_engine_remove(&daemon->engine, &sensor->async);
+		sensor->running = 0;
+		return;
+	}
+	sensor->async.interval_usec = sensor->hub.period_usec;
+	if (!sensor->running &&
+	bmp280_engine_add(&daemon->engine, &sensor->async,
+	BMP280_get_time_usec()) == SUCCESS)
+		sensor->running = 1;
+}
+
+/* seals of the shared memory ring: the clients may neither write nor
+ * resize it, only the mapping of the daemon stays writable */
+#define	BMP280_DAEMON_SHM_SEALS	(F_SEAL_SEAL | F_SEAL_SHRINK |\
+	F_SEAL_GROW | F_SEAL_FUTURE_WRITE)
+
+/*	\Brief: Creates the shared memory ring of a sensor on first use, as an
+ *	anonymous memfd that is only reachable through the passed descriptors.
+ *	The memfd is sealed after the daemon mapped it, so the descriptor the
+ *	clients get is read-only.
+ *	\Return : 0 on success
+ */
+static s32 bmp280_daemon_shm_ring(struct bmp280_daemon_sensor_t *sensor)
+{
+	void *map = MAP_FAILED;
+
+	if (sensor->shm != NULL)
+		return SUCCESS;
+	bmp280_shm_ring_size(BMP280_DAEMON_SHM_SIZE, &sensor->shm_size);
+	sensor->shm_fd = memfd_create("bmp280_ring",
+	MFD_CLOEXEC | MFD_ALLOW_SEALING);
+	if (sensor->shm_fd < 0)
+		return ERROR;
+	if (ftruncate(sensor->shm_fd, sensor->shm_size) == 0)
+		map = mmap(NULL, sensor->shm_size, PROT_READ | PROT_WRITE,
+		MAP_SHARED, sensor->shm_fd, 0);
+	if (map != MAP_FAILED && fcntl(sensor->shm_fd, F_ADD_SEALS,
+	BMP280_DAEMON_SHM_SEALS) != 0) {
+		munmap(map, sensor->shm_size);
+		map = MAP_FAILED;
+	}
+	if (map == MAP_FAILED) {
+		close(sensor->shm_fd);
+		sensor->shm_fd = -1;
+		return ERROR;
+	}
+	sensor->shm = (struct bmp280_shm_ring_t *)map;
+	return bmp280_shm_ring_init(sensor->shm, BMP280_DAEMON_SHM_SIZE);
+}
+
+/*	\Brief: Sends one frame with a file descriptor attached (SCM_RIGHTS)
+ *	\Return : 0 on success
+ */
+static s32 bmp280_daemon_send_fd(int sock_fd, u8 *frame, u32 v_len_u32,
+int pass_fd)
+{
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cmsg = NULL;
+	union {
+		struct cmsghdr align;
+		char buf[CMSG_SPACE(sizeof(int))];
+	} control;
+
+	memset(&msg, 0, sizeof(msg));
+	memset(&control, 0, sizeof(control));
+	iov.iov_base = frame;
+	iov.iov_len = v_len_u32;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buf;
+	msg.msg_controllen = sizeof(control.buf);
+	cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+	memcpy(CMSG_DATA(cmsg), &pass_fd, sizeof(int));
+	return sendmsg(sock_fd, &msg, MSG_NOSIGNAL) == (ssize_t)v_len_u32 ?
+	SUCCESS : ERROR;
+}
+
+/*	\Brief: Ends the subscription of a client, if any */
+static void bmp280_daemon_unsubscribe(struct bmp280_daemon_t *daemon,
+struct bmp280_daemon_client_t *client)
+{
+	struct bmp280_daemon_sensor_t *sensor = NULL;
+
+	if (!client->subscribed)
+		return;
+	sensor = &daemon->sensor[client->sensor];
+	bmp280_hub_unsubscribe(&sensor->hub, &client->sub);
+	client->subscribed = 0;
+	bmp280_daemon_update_sensor(daemon, sensor);
+}
+
+/*	\Brief: Answers a request of a client with a status frame
+ *	\Return : v_status_s8
+ */
+static s32 bmp280_daemon_send_status(struct bmp280_daemon_client_t *client,
+u8 v_sensor_u8, s8 v_status_s8)
+{
+	u8 a_frame_u8[BMP280_FRAME_HEADER_LEN + BMP280_FRAME_STATUS_LEN];
+
+	bmp280_frame_put_status(a_frame_u8, v_sensor_u8, v_status_s8);
+	send(client->fd, a_frame_u8, sizeof(a_frame_u8),
+	MSG_DONTWAIT | MSG_NOSIGNAL);
+	return v_status_s8;
+}
+
+/*	\Brief: Subscribes a client to a sensor. Socket clients get a status
+ *	frame, then samples frames of batch samples; shared memory clients get
+ *	the descriptor of the ring of the sensor once and read it themselves.
+ *	A rejected request is answered with a status frame holding the error.
+ *	Both kinds count towards the sampling rate of the sensor.
+ *	\Return : 0 on success
+ */
+static s32 bmp280_daemon_subscribe(struct bmp280_daemon_t *daemon,
+struct bmp280_daemon_client_t *client, u8 v_sensor_u8,
+u32 v_period_usec_u32, u8 v_batch_u8, u8 v_flags_u8)
+{
+	u8 a_frame_u8[BMP280_FRAME_HEADER_LEN + BMP280_FRAME_SHM_RING_LEN];
+	struct bmp280_daemon_sensor_t *sensor = NULL;
+
+	if (v_sensor_u8 >= daemon->sensor_count)
+		return bmp280_daemon_send_status(client, v_sensor_u8,
+		E_BMP280_OUT_OF_RANGE);
+	bmp280_daemon_unsubscribe(daemon, client);
+	sensor = &daemon->sensor[v_sensor_u8];
+	if ((v_flags_u8 & BMP280_FRAME_FLAG_SHM) &&
+	bmp280_daemon_shm_ring(sensor) != SUCCESS)
+		return bmp280_daemon_send_status(client, v_sensor_u8, ERROR);
+	if (bmp280_hub_subscribe(&sensor->hub, &client->sub,
+	v_period_usec_u32) != SUCCESS)
+		return bmp280_daemon_send_status(client, v_sensor_u8,
+		E_BMP280_OUT_OF_RANGE);
+	client->sensor = v_sensor_u8;
+	client->batch = v_batch_u8 == 0 ? 1 : v_batch_u8;
+	if (client->batch > BMP280_DAEMON_BATCH_MAX)
+		client->batch = BMP280_DAEMON_BATCH_MAX;
+	client->shm = (v_flags_u8 & BMP280_FRAME_FLAG_SHM) ? 1 : 0;
+	client->subscribed = 1;
+	bmp280_daemon_update_sensor(daemon, sensor);
+	if (!client->shm)
+		return bmp280_daemon_send_status(client, v_sensor_u8, SUCCESS);
+	bmp280_frame_put_shm_ring(a_frame_u8, v_sensor_u8,
+	BMP280_DAEMON_SHM_SIZE);
+	return bmp280_daemon_send_fd(client->fd, a_frame_u8,
+	sizeof(a_frame_u8), sensor->shm_fd);
+}
+
+/*	\Brief: Disconnects a client and releases its entry */
+static void bmp280_daemon_close_client(struct bmp280_daemon_t *daemon,
+struct bmp280_daemon_client_t *client)
+{
+	bmp280_daemon_unsubscribe(daemon, client);
+	epoll_ctl(daemon->epoll_fd, EPOLL_CTL_DEL, client->fd, NULL);
+	close(client->fd);
+	client->fd = -1;
+}
+
+/*	\Brief: Accepts all pending connections */
+static void bmp280_daemon_accept(struct bmp280_daemon_t *daemon)
+{
+	struct epoll_event ev;
+	int fd = -1;
+	u8 v_index_u8 = 0;
+
+	while ((fd = accept4(daemon->listen_fd, NULL, NULL,
+	SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+		for (v_index_u8 = 0; v_index_u8 < BMP280_DAEMON_MAX_CLIENT;
+		v_index_u8++)
+			if (daemon->client[v_index_u8].fd < 0)
+				break;
+		if (v_index_u8 == BMP280_DAEMON_MAX_CLIENT) {
+			close(fd);
+			continue;
+		}
+		memset(&daemon->client[v_index_u8], 0,
+		sizeof(daemon->client[v_index_u8]));
+		daemon->client[v_index_u8].fd = fd;
+		ev.events = EPOLLIN;
+		ev.data.u32 = BMP280_DAEMON_EV_CLIENT + v_index_u8;
+		epoll_ctl(daemon->epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+	}
+}
+
+/*	\Brief: Handles the frames a client sent; the socket is of type
+ *	SOCK_SEQPACKET, so each message holds exactly one frame
+ */
+static void bmp280_daemon_client_input(struct bmp280_daemon_t *daemon,
+struct bmp280_daemon_client_t *client)
+{
+	u8 a_frame_u8[BMP280_FRAME_HEADER_LEN + BMP280_FRAME_SUBSCRIBE_LEN];
+	u32 v_period_usec_u32 = 0;
+	u16 v_payload_len_u16 = 0;
+	u8 v_type_u8 = 0;
+	u8 v_sensor_u8 = 0;
+	u8 v_batch_u8 = 0;
+	u8 v_flags_u8 = 0;
+	ssize_t v_len = 0;
+
+	for (;;) {
+		v_len = recv(client->fd, a_frame_u8, sizeof(a_frame_u8), 0);
+		if (v_len == 0 || (v_len < 0 && errno != EAGAIN &&
+		errno != EINTR)) {
+			bmp280_daemon_close_client(daemon, client);
+			return;
+		}
+		if (v_len < 0)
+			return;
+		if (bmp280_frame_get_header(a_frame_u8, (u32)v_len, &v_type_u8,
+		&v_sensor_u8, &v_payload_len_u16) != SUCCESS)
+			continue;
+		if (v_type_u8 == BMP280_FRAME_SUBSCRIBE &&
+		bmp280_frame_get_subscribe(a_frame_u8 + BMP280_FRAME_HEADER_LEN,
+		v_payload_len_u16, &v_period_usec_u32, &v_batch_u8,
+		&v_flags_u8) == SUCCESS)
+			bmp280_daemon_subscribe(daemon, client, v_sensor_u8,
+			v_period_usec_u32, v_batch_u8, v_flags_u8);
+		else if (v_type_u8 == BMP280_FRAME_UNSUBSCRIBE)
+			bmp280_daemon_unsubscribe(daemon, client);
+	}
+}
+
+/*	\Brief: Sends a samples frame to every socket client with at least a
+ *	batch of samples pending, or as many as the hub can hold. A full
+ *	socket never stalls the daemon: the samples are dropped for that
+ *	client only and counted.
+ */
+static void bmp280_daemon_deliver(struct bmp280_daemon_t *daemon)
+{
+	struct bmp280_sample_t a_sample[BMP280_DAEMON_BATCH_MAX];
+	u8 a_frame_u8[BMP280_DAEMON_FRAME_LEN];
+	struct bmp280_daemon_client_t *client = NULL;
+	struct bmp280_hub_t *hub = NULL;
+	u32 v_want_u32 = 0;
+	u32 v_count_u32 = 0;
+	u32 v_frame_len_u32 = 0;
+	u8 v_index_u8 = 0;
+
+	for (v_index_u8 = 0; v_index_u8 < BMP280_DAEMON_MAX_CLIENT;
+	v_index_u8++) {
+		client = &daemon->client[v_index_u8];
+		if (client->fd < 0 || !client->subscribed || client->shm)
+			continue;
+		hub = &daemon->sensor[client->sensor].hub;
+		/* a batch that does not fit the hub is sent early, before
+		the producer laps the client */
+		v_want_u32 = client->batch * client->sub.stride;
+		if (v_want_u32 + client->sub.stride > hub->mask + 1)
+			v_want_u32 = client->sub.stride > hub->mask ?
+			client->sub.stride :
+			hub->mask + 1 - client->sub.stride;
+		if ((s32)(hub->head - client->sub.cursor) < (s32)v_want_u32)
+			continue;
+		bmp280_hub_pop_batch(hub, &client->sub, a_sample,
+		BMP280_DAEMON_BATCH_MAX, &v_count_u32);
+		if (v_count_u32 == 0)
+			continue;
+		bmp280_frame_put_samples(a_frame_u8, sizeof(a_frame_u8),
+		client->sensor, a_sample, (u16)v_count_u32, &v_frame_len_u32);
+		if (send(client->fd, a_frame_u8, v_frame_len_u32,
+		MSG_DONTWAIT | MSG_NOSIGNAL) == (ssize_t)v_frame_len_u32)
+			continue;
+		if (errno == EAGAIN || errno == EWOULDBLOCK)
+			client->drop_count += v_count_u32;
+		else
+			bmp280_daemon_close_client(daemon, client);
+	}
+}
+
+/*	\Brief: Sets up the daemon on a Unix domain socket of type
+ *	SOCK_SEQPACKET; sensor[].async.dev and sensor_count have to be set
+ *	before, the devices initialized and in sleep mode
+ *	\Return : 0 on success
+ *	\param daemon : The daemon
+ *	\param path : Path of the socket, replaced if it exists
+ */
+s32 bmp280_daemon_start(struct bmp280_daemon_t *daemon, const char *path)
+{
+	struct sockaddr_un addr;
+	struct epoll_event ev;
+	struct bmp280_daemon_sensor_t *sensor = NULL;
+	u8 v_index_u8 = 0;
+
+	if (daemon->sensor_count > BMP280_DAEMON_MAX_SENSOR ||
+	strlen(path) >= sizeof(addr.sun_path))
+		return E_BMP280_OUT_OF_RANGE;
+	bmp280_engine_init(&daemon->engine, daemon->heap,
+	BMP280_DAEMON_MAX_SENSOR);
+	for (v_index_u8 = 0; v_index_u8 < daemon->sensor_count; v_index_u8++) {
+		sensor = &daemon->sensor[v_index_u8];
+		bmp280_hub_init(&sensor->hub, sensor->hub_buffer,
+		BMP280_DAEMON_HUB_SIZE, sensor->hub_sub,
+		BMP280_DAEMON_MAX_CLIENT);
+		sensor->async.ring = NULL;
+		sensor->async.hub = &sensor->hub;
+		sensor->async.sample_cb = bmp280_daemon_sample_cb;
+		sensor->async.user_data = sensor;
+		sensor->shm = NULL;
+		sensor->shm_fd = -1;
+		sensor->running = 0;
+	}
+	for (v_index_u8 = 0; v_index_u8 < BMP280_DAEMON_MAX_CLIENT; v_index_u8++)
+		daemon->client[v_index_u8].fd = -1;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+	unlink(path);
+	daemon->listen_fd = socket(AF_UNIX,
+	SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	daemon->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	daemon->timer_fd = timerfd_create(CLOCK_MONOTONIC,
+	TFD_NONBLOCK | TFD_CLOEXEC);
+	if (daemon->listen_fd < 0 || daemon->epoll_fd < 0 ||
+	daemon->timer_fd < 0 ||
+	bind(daemon->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) ||
+	listen(daemon->listen_fd, BMP280_DAEMON_MAX_CLIENT))
+		return ERROR;
+	ev.events = EPOLLIN;
+	ev.data.u32 = BMP280_DAEMON_EV_LISTEN;
+	epoll_ctl(daemon->epoll_fd, EPOLL_CTL_ADD, daemon->listen_fd, &ev);
+	ev.data.u32 = BMP280_DAEMON_EV_TIMER;
+	epoll_ctl(daemon->epoll_fd, EPOLL_CTL_ADD, daemon->timer_fd, &ev);
+	return SUCCESS;
+}
+
+/*	\Brief: Runs the daemon on the calling thread until stop_fd (e.g. an
+ *	eventfd) becomes readable. Every sensor is read once per sample at the
+ *	fastest rate requested, whatever the number of clients.
+ *	\Return : communication result
+ *	\param daemon : The daemon
+ *	\param stop_fd : File descriptor that ends the loop, -1 for none
+ */
+s32 bmp280_daemon_run(struct bmp280_daemon_t *daemon, int stop_fd)
+{
+	struct epoll_event ev;
+	struct epoll_event events[BMP280_DAEMON_MAX_CLIENT + 3];
+	struct itimerspec disarm = {{0, 0}, {0, 0}};
+	u64 v_expirations_u64 = 0;
+	u32 v_deadline_u32 = BMP280_ZERO_U8X;
+	u32 v_tag_u32 = 0;
+	s32 com_rslt = SUCCESS;
+	int v_ready = 0;
+	int v_index = 0;
+	int v_run = 1;
+
+	if (stop_fd >= 0) {
+		ev.events = EPOLLIN;
+		ev.data.u32 = BMP280_DAEMON_EV_STOP;
+		epoll_ctl(daemon->epoll_fd, EPOLL_CTL_ADD, stop_fd, &ev);
+	}
+	while (v_run) {
+		if (bmp280_engine_next_deadline(&daemon->engine,
+		&v_deadline_u32) == SUCCESS)
+			bmp280_timerfd_arm(daemon->timer_fd, v_deadline_u32);
+		else
+			timerfd_settime(daemon->timer_fd, 0, &disarm, NULL);
+		v_ready = epoll_wait(daemon->epoll_fd, events,
+		BMP280_DAEMON_MAX_CLIENT + 3, -1);
+		for (v_index = 0; v_index < v_ready; v_index++) {
+			v_tag_u32 = events[v_index].data.u32;
+			if (v_tag_u32 == BMP280_DAEMON_EV_STOP) {
+				v_run = 0;
+			} else if (v_tag_u32 == BMP280_DAEMON_EV_LISTEN) {
+				bmp280_daemon_accept(daemon);
+			} else if (v_tag_u32 == BMP280_DAEMON_EV_TIMER) {
+				if (read(daemon->timer_fd, &v_expirations_u64,
+				sizeof(v_expirations_u64)) > 0)
+					com_rslt = bmp280_first_error(
+					com_rslt, bmp280_engine_run(
+					&daemon->engine,
+					BMP280_get_time_usec()));
+			} else if (daemon->client[v_tag_u32 -
+			BMP280_DAEMON_EV_CLIENT].fd >= 0) {
+				bmp280_daemon_client_input(daemon,
+				&daemon->client[v_tag_u32 -
+				BMP280_DAEMON_EV_CLIENT]);
+			}
+		}
+		bmp280_daemon_deliver(daemon);
+	}
+	if (stop_fd >= 0)
+		epoll_ctl(daemon->epoll_fd, EPOLL_CTL_DEL, stop_fd, NULL);
+	return com_rslt;
+}
+
+/*	\Brief: Disconnects all clients and releases the socket, the event
+ *	descriptors and the shared memory rings
+ *	\param daemon : The daemon
+ *	\param path : Path of the socket
+ */
+void bmp280_daemon_stop(struct bmp280_daemon_t *daemon, const char *path)
+{
+	struct bmp280_daemon_sensor_t *sensor = NULL;
+	u8 v_index_u8 = 0;
+
+	for (v_index_u8 = 0; v_index_u8 < BMP280_DAEMON_MAX_CLIENT; v_index_u8++)
+		if (daemon->client[v_index_u8].fd >= 0)
+			bmp280_daemon_close_client(daemon,
+			&daemon->client[v_index_u8]);
+	for (v_index_u8 = 0; v_index_u8 < daemon->sensor_count; v_index_u8++) {
+		sensor = &daemon->sensor[v_index_u8];
+		if (sensor->shm != NULL) {
+			munmap(sensor->shm, sensor->shm_size);
+			close(sensor->shm_fd);
+			sensor->shm = NULL;
+		}
+	}
+	close(daemon->timer_fd);
+	close(daemon->epoll_fd);
+	close(daemon->listen_fd);
+	unlink(path);
+}
+
+/* time the client waits for the answer to its subscribe frame */
+#define	BMP280_CLIENT_TIMEOUT_MSEC	1000
+
+/*	\Brief: Client side: connects to the daemon and subscribes to a
+ *	sensor. With BMP280_FRAME_FLAG_SHM the ring descriptor that comes
+ *	back is mapped read only into *ring, else a status frame confirms
+ *	the subscription and samples frames follow on the returned socket.
+ *	A status frame with an error, or no answer within
+ *	BMP280_CLIENT_TIMEOUT_MSEC, fails the call.
+ *	\Return : The connected socket, -1 on failure
+ *	\param path : Path of the daemon socket
+ *	\param v_sensor_u8 : The sensor
+ *	\param v_period_usec_u32 : Requested sample period in us
+ *	\param v_batch_u8 : Samples per frame
+ *	\param v_flags_u8 : 0 or BMP280_FRAME_FLAG_SHM
+ *	\param ring : The mapped ring, only with BMP280_FRAME_FLAG_SHM
+ */
+int bmp280_client_connect(const char *path, u8 v_sensor_u8,
+u32 v_period_usec_u32, u8 v_batch_u8, u8 v_flags_u8,
+const struct bmp280_shm_ring_t **ring)
+{
+	u8 a_frame_u8[BMP280_FRAME_HEADER_LEN + BMP280_FRAME_SUBSCRIBE_LEN];
+	struct sockaddr_un addr;
+	struct timeval v_timeout;
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cmsg = NULL;
+	union {
+		struct cmsghdr align;
+		char buf[CMSG_SPACE(sizeof(int))];
+	} control;
+	void *map = MAP_FAILED;
+	u32 v_capacity_u32 = 0;
+	u32 v_size_u32 = 0;
+	u16 v_payload_len_u16 = 0;
+	u8 v_type_u8 = 0;
+	u8 v_sensor_u8_rx = 0;
+	s8 v_status_s8 = ERROR;
+	ssize_t v_len = 0;
+	int ring_fd = -1;
+	int fd = -1;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+	fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return -1;
+	bmp280_frame_put_subscribe(a_frame_u8, v_sensor_u8, v_period_usec_u32,
+	v_batch_u8, v_flags_u8);
+	v_timeout.tv_sec = BMP280_CLIENT_TIMEOUT_MSEC / 1000;
+	v_timeout.tv_usec = (BMP280_CLIENT_TIMEOUT_MSEC % 1000) * 1000;
+	if (setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &v_timeout,
+	sizeof(v_timeout)) ||
+	connect(fd, (struct sockaddr *)&addr, sizeof(addr)) ||
+	send(fd, a_frame_u8, sizeof(a_frame_u8), MSG_NOSIGNAL) !=
+	(ssize_t)sizeof(a_frame_u8)) {
+		close(fd);
+		return -1;
+	}
+	memset(&msg, 0, sizeof(msg));
+	iov.iov_base = a_frame_u8;
+	iov.iov_len = sizeof(a_frame_u8);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buf;
+	msg.msg_controllen = sizeof(control.buf);
+	v_len = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+	cmsg = v_len > 0 ? CMSG_FIRSTHDR(&msg) : NULL;
+	if (cmsg != NULL && cmsg->cmsg_level == SOL_SOCKET &&
+	cmsg->cmsg_type == SCM_RIGHTS)
+		memcpy(&ring_fd, CMSG_DATA(cmsg), sizeof(int));
+	if (v_len <= 0 || bmp280_frame_get_header(a_frame_u8, (u32)v_len,
+	&v_type_u8, &v_sensor_u8_rx, &v_payload_len_u16) != SUCCESS)
+		v_type_u8 = 0;
+	if (v_type_u8 == BMP280_FRAME_STATUS &&
+	!(v_flags_u8 & BMP280_FRAME_FLAG_SHM) &&
+	bmp280_frame_get_status(a_frame_u8 + BMP280_FRAME_HEADER_LEN,
+	v_payload_len_u16, &v_status_s8) != SUCCESS)
+		v_status_s8 = ERROR;
+	if (ring_fd >= 0 && v_type_u8 == BMP280_FRAME_SHM_RING &&
+	(v_flags_u8 & BMP280_FRAME_FLAG_SHM) &&
+	bmp280_frame_get_shm_ring(a_frame_u8 + BMP280_FRAME_HEADER_LEN,
+	v_payload_len_u16, &v_capacity_u32) == SUCCESS &&
+	bmp280_shm_ring_size(v_capacity_u32, &v_size_u32) == SUCCESS)
+		map = mmap(NULL, v_size_u32, PROT_READ, MAP_SHARED, ring_fd, 0);
+	if (ring_fd >= 0)
+		close(ring_fd);
+	if (map != MAP_FAILED) {
+		*ring = (const struct bmp280_shm_ring_t *)map;
+		v_status_s8 = SUCCESS;
+	}
+	if (v_status_s8 != SUCCESS) {
+		close(fd);
+		return -1;
+	}
+	/* samples frames may be far apart, reads block again */
+	v_timeout.tv_sec = 0;
+	v_timeout.tv_usec = 0;
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &v_timeout, sizeof(v_timeout));
+	return fd;
+}
+
+#if defined(BMP280_ENABLE_INT64) && defined(BMP280_64BITSUPPORT_PRESENT)
+/* samples per block of the example log file */
+#define	BMP280_LOG_FILE_BLOCK	1024
+/* bmp280_log_block_bound() of a block, in 8 byte words */
+#define	BMP280_LOG_FILE_BOUND_WORDS	((BMP280_LOG_HEADER_LEN +\
+	BMP280_LOG_FILE_BLOCK * BMP280_LOG_STREAMS * BMP280_LOG_MAX_WIDTH / 8 +\
+	BMP280_LOG_ALIGN) / 8)
+
+/* Append-only binary log file of one device, with its index */
+struct bmp280_log_file_t {
+	int fd;
+	/* index file, -1 if none */
+	int index_fd;
+	/* size of the file, i.e. offset of the next block */
+	u64 offset;
+	struct bmp280_log_writer_t writer;
+	struct bmp280_sample_t sample[BMP280_LOG_FILE_BLOCK];
+	u64 block[BMP280_LOG_FILE_BOUND_WORDS];
+};
+
+/*	\Brief: Opens or creates a log file for appending blocks of dev,
+ *	with an index file getting one entry per block
+ *	\Return : 0 on success
+ *	\param log : The log file
+ *	\param dev : The device, its calibration goes into every block
+ *	\param path : Path of the file
+ *	\param index_path : Path of the index file, NULL for none; index
+ *	times are microseconds since the epoch
+ */
+s32 bmp280_log_file_open(struct bmp280_log_file_t *log,
+const struct bmp280_t *dev, const char *path, const char *index_path)
+{
+	struct timespec v_now;
+	off_t v_end = 0;
+
+	log->index_fd = -1;
+	log->fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+	if (log->fd < 0)
+		return ERROR;
+	if (index_path != NULL) {
+		log->index_fd = open(index_path,
+		O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+		if (log->index_fd < 0) {
+			close(log->fd);
+			log->fd = -1;
+			return ERROR;
+		}
+	}
+	v_end = lseek(log->fd, 0, SEEK_END);
+	log->offset = v_end < 0 ? 0 : (u64)v_end;
+	if (bmp280_log_writer_init(&log->writer, dev, log->sample,
+	BMP280_LOG_FILE_BLOCK) != SUCCESS)
+		return ERROR;
+	/* the first sample is taken from now on */
+	clock_gettime(CLOCK_REALTIME, &v_now);
+	log->writer.time_usec = (u64)v_now.tv_sec * BMP280_USEC_PER_SEC +
+	(u64)v_now.tv_nsec / 1000;
+	return SUCCESS;
+}
+
+/*	\Brief: Appends the encoded block of v_len_u32 bytes to the file
+ *	\Return : 0 on success
+ */
+static s32 bmp280_log_file_append(struct bmp280_log_file_t *log,
+u32 v_len_u32)
+{
+	const u8 *v_data_u8 = (const u8 *)log->block;
+	u8 v_entry_u8[BMP280_LOG_INDEX_LEN];
+	ssize_t v_done = 0;
+
+	while (v_len_u32 > 0) {
+		v_done = write(log->fd, v_data_u8, v_len_u32);
+		if (v_done < 0 && errno == EINTR)
+			continue;
+		if (v_done <= 0)
+			return ERROR;
+		v_data_u8 += v_done;
+		v_len_u32 -= (u32)v_done;
+		log->offset += (u64)v_done;
+	}
+	/* the index entry follows its block, so it never points past
+	 * the end of the log */
+	if (log->index_fd < 0)
+		return SUCCESS;
+	bmp280_log_index_put(&log->writer.index, v_entry_u8);
+	if (write(log->index_fd, v_entry_u8, BMP280_LOG_INDEX_LEN) !=
+	BMP280_LOG_INDEX_LEN)
+		return ERROR;
+	return SUCCESS;
+}
+
+/*	\Brief: Logs one sample; a block is written every
+ *	BMP280_LOG_FILE_BLOCK samples
+ *	\Return : 0 on success
+ *	\param log : The log file
+ *	\param sample : The sample, only raw codes and timestamp are kept
+ */
+s32 bmp280_log_file_push(struct bmp280_log_file_t *log,
+const struct bmp280_sample_t *sample)
+{
+	u32 v_len_u32 = 0;
+	s32 com_rslt = SUCCESS;
+
+	log->writer.offset = log->offset;
+	com_rslt = bmp280_log_writer_push(&log->writer, sample,
+	(u8 *)log->block, sizeof(log->block), &v_len_u32);
+	if (com_rslt == SUCCESS && v_len_u32 > 0)
+		com_rslt = bmp280_log_file_append(log, v_len_u32);
+	return com_rslt;
+}
+
+/*	\Brief: Writes the open block and closes the file
+ *	\Return : 0 on success
+ *	\param log : The log file
+ */
+s32 bmp280_log_file_close(struct bmp280_log_file_t *log)
+{
+	u32 v_len_u32 = 0;
+	s32 com_rslt = SUCCESS;
+
+	log->writer.offset = log->offset;
+	com_rslt = bmp280_log_writer_flush(&log->writer, (u8 *)log->block,
+	sizeof(log->block), &v_len_u32);
+	if (com_rslt == SUCCESS && v_len_u32 > 0)
+		com_rslt = bmp280_log_file_append(log, v_len_u32);
+	if (close(log->fd))
+		com_rslt = ERROR;
+	if (log->index_fd >= 0 && close(log->index_fd))
+		com_rslt = ERROR;
+	log->fd = -1;
+	log->index_fd = -1;
+	return com_rslt;
+}
+
+/*	\Brief: Sample callback for the acquisition engine that logs each
+ *	sample to the log file given in async->user_data
+ *	\param async : The sensor
+ *	\param sample : The sample, NULL on a failed read
+ *	\param v_rslt_s8 : Communication result of the read
+ */
+void bmp280_log_sample_cb(struct bmp280_async_t *async,
+const struct bmp280_sample_t *sample, s8 v_rslt_s8)
+{
+	if (sample != NULL && v_rslt_s8 == SUCCESS)
+		bmp280_log_file_push((struct bmp280_log_file_t *)async->user_data,
+		sample);
+}
+
+/* index entries read at a time by the query */
+#define	BMP280_LOG_QUERY_ENTRIES	64
+
+/* Scratch of a log query: one block and its samples */
+struct bmp280_log_scan_t {
+	u64 block[BMP280_LOG_FILE_BOUND_WORDS];
+	struct bmp280_sample_t sample[BMP280_LOG_FILE_BLOCK];
+};
+
+/*	\Brief: Runs a range query over a log file through its index:
+ *	only blocks whose index entry may match the time, raw and physical
+ *	ranges are read, and only their samples within the time and raw
+ *	ranges are compensated
+ *	\Return : 0 on success
+ *	\param path : Path of the log file
+ *	\param index_path : Path of its index file
+ *	\param query : The query, see bmp280_log_query_init(); its
+ *	counters report the blocks skipped and samples compensated
+ *	\param match : Called with the matching samples of each block
+ *	\param user_data : Passed to match
+ */
+s32 bmp280_log_file_query(const char *path, const char *index_path,
+struct bmp280_log_query_t *query,
+void (*match)(void *, const struct bmp280_sample_t *, u32), void *user_data)
+{
+	u8 v_entry_u8[BMP280_LOG_QUERY_ENTRIES * BMP280_LOG_INDEX_LEN];
+	struct bmp280_log_index_t index;
+	struct bmp280_log_block_t block;
+	struct bmp280_calib_param_t calib;
+	struct bmp280_log_scan_t *scan = NULL;
+	ssize_t v_done = 0;
+	ssize_t v_torn = 0;
+	ssize_t v_pos = 0;
+	ssize_t v_read = 0;
+	u32 v_count_u32 = 0;
+	s32 com_rslt = SUCCESS;
+	u8 v_match_u8 = 0;
+	u8 v_calib_u8 = 0;
+	int fd = -1;
+	int index_fd = -1;
+
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	index_fd = open(index_path, O_RDONLY | O_CLOEXEC);
+	scan = malloc(sizeof(*scan));
+	if (fd < 0 || index_fd < 0 || scan == NULL)
+		com_rslt = ERROR;
+	/* the file holds one device, the calibration of its first block
+	 * lets the index skip blocks on the physical ranges as well */
+	if (com_rslt == SUCCESS) {
+		v_read = pread(fd, scan->block, sizeof(scan->block), 0);
+		if (v_read > 0 &&
+		bmp280_log_decode_header((const u8 *)scan->block,
+		(u32)v_read, &block) == SUCCESS) {
+			calib = block.calib_param;
+			v_calib_u8 = 1;
+		}
+	}
+	while (com_rslt == SUCCESS) {
+		v_done = read(index_fd, v_entry_u8, sizeof(v_entry_u8));
+		if (v_done < 0 && errno == EINTR)
+			continue;
+		if (v_done <= 0) {
+			com_rslt = v_done < 0 ? ERROR : SUCCESS;
+			break;
+		}
+		/* a torn entry is read again at the start of the next
+		chunk; alone at the end of the index, it is one still
+		being written and the query stops before it */
+		v_torn = v_done % BMP280_LOG_INDEX_LEN;
+		v_done -= v_torn;
+		if (v_done == 0)
+			break;
+		if (v_torn != 0 &&
+		lseek(index_fd, -(off_t)v_torn, SEEK_CUR) < 0) {
+			com_rslt = ERROR;
+			break;
+		}
+		for (v_pos = 0; v_pos < v_done && com_rslt == SUCCESS;
+		v_pos += BMP280_LOG_INDEX_LEN) {
+			com_rslt = bmp280_log_index_get(&v_entry_u8[v_pos],
+			&index);
+			if (com_rslt == SUCCESS)
+				com_rslt = bmp280_log_query_index(query, &index,
+				v_calib_u8 ? &calib : NULL, &v_match_u8);
+			if (com_rslt != SUCCESS || !v_match_u8)
+				continue;
+			v_count_u32 = 0;
+			v_read = pread(fd, scan->block, sizeof(scan->block),
+			(off_t)index.offset);
+			if (v_read < 0 ||
+			bmp280_log_decode_header((const u8 *)scan->block,
+			(u32)v_read, &block) != SUCCESS)
+				com_rslt = ERROR;
+			else
+				com_rslt = bmp280_log_query_block(query, &index,
+				&block, scan->sample, BMP280_LOG_FILE_BLOCK,
+				&v_count_u32);
+			if (com_rslt == SUCCESS && v_count_u32 > 0)
+				match(user_data, scan->sample, v_count_u32);
+		}
+	}
+	free(scan);
+	if (fd >= 0)
+		close(fd);
+	if (index_fd >= 0)
+		close(index_fd);
+	return com_rslt;
+}
+
+/* Log file mapped read-only for replay */
+struct bmp280_log_map_t {
+	const u8 *data;
+	size_t len;
+};
+
+/*	\Brief: Maps a log file read-only and tells the kernel it will
+ *	be read front to back, so it reads ahead and drops pages behind
+ *	\Return : 0 on success
+ *	\param map : The mapping
+ *	\param path : Path of the log file
+ */
+s32 bmp280_log_map_open(struct bmp280_log_map_t *map, const char *path)
+{
+	struct stat v_stat;
+	void *v_addr = MAP_FAILED;
+	size_t v_len = 0;
+	int fd = -1;
+
+	map->data = NULL;
+	map->len = 0;
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return ERROR;
+	if (fstat(fd, &v_stat) == 0 && v_stat.st_size > 0) {
+		v_len = (size_t)v_stat.st_size;
+		v_addr = mmap(NULL, v_len, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	/* the mapping keeps the file open */
+	close(fd);
+	if (v_addr == MAP_FAILED)
+		return ERROR;
+	madvise(v_addr, v_len, MADV_SEQUENTIAL);
+	map->data = (const u8 *)v_addr;
+	map->len = v_len;
+	return SUCCESS;
+}
+
+/*	\Brief: Unmaps a log file
+ *	\Return : 0 on success
+ *	\param map : The mapping
+ */
+s32 bmp280_log_map_close(struct bmp280_log_map_t *map)
+{
+	s32 com_rslt = SUCCESS;
+
+	if (map->data != NULL && munmap((void *)map->data, map->len))
+		com_rslt = ERROR;
+	map->data = NULL;
+	map->len = 0;
+	return com_rslt;
+}
+
+/* samples per batch of a replay */
+#define	BMP280_LOG_REPLAY_BATCH	4096
+
+/*	\Brief: Replays a mapped log: blocks are decoded straight from
+ *	the mapping and compensated in batches, which are handed to the
+ *	callback; files can be replayed from one thread each
+ *	\Return : 0 on success, -2 if the log ends in a truncated block
+ *	\param map : The mapping
+ *	\param batch : Called with each batch of compensated samples
+ *	\param user_data : Passed to batch
+ */
+s32 bmp280_log_map_replay(const struct bmp280_log_map_t *map,
+void (*batch)(void *, const struct bmp280_sample_t *, u32), void *user_data)
+{
+	struct bmp280_log_cursor_t cursor;
+	struct bmp280_sample_t *sample = NULL;
+	u32 v_count_u32 = 0;
+	s32 com_rslt = SUCCESS;
+
+	sample = malloc(BMP280_LOG_REPLAY_BATCH * sizeof(*sample));
+	if (sample == NULL)
+		return ERROR;
+	com_rslt = bmp280_log_cursor_init(&cursor, map->data, map->len);
+	while (com_rslt == SUCCESS) {
+		com_rslt = bmp280_log_cursor_next(&cursor, sample,
+		BMP280_LOG_REPLAY_BATCH, &v_count_u32);
+		if (v_count_u32 == 0)
+			break;
+		batch(user_data, sample, v_count_u32);
+	}
+	free(sample);
+	return com_rslt;
+}
+#endif
+#endif